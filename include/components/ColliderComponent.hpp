@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Component.hpp"
+#include <Physics2D.hpp>
+#include <Transform2D.hpp>
+#include <RegistryManager.hpp>
+#include <LuaManager.hpp>
+#include <stdexcept>
+#include <iostream>
+
+// Lua handle for a Collider2D; the shape itself lives on the owner and is read by PhysicsSystem
+class ColliderComponent : public Component {
+public:
+    explicit ColliderComponent(ColliderShape shape = ColliderShape::Box, const Vector2& size = Vector2(),
+                               const Vector2& offset = Vector2(), bool enabled = true);
+    ~ColliderComponent() override;
+
+    void Emplace(entt::entity owner) override;
+
+    static void Register();
+
+    // The owner's collider once emplaced, otherwise the settings it will start with
+    Collider2D& GetCollider();
+
+    void SetEnabled(bool enabled);
+    void SetSize(const Vector2& size);
+    void SetOffset(const Vector2& offset);
+
+private:
+    Collider2D initial_collider;
+    Collider2D* collider = nullptr; // Lives in the registry; stable for the owner's lifetime
+
+    // Keep the owner's broadphase bounds covering the shape
+    void UpdateBounds();
+    void InitializeLuaBindings();
+};
@@ -7,10 +7,13 @@
 #include <iostream>
 #include <RegistryManager.hpp>
 #include <LuaManager.hpp>
+#include <EnvironmentPool.hpp>
+#include <ObjectPool.hpp>
+#include <ObjectType.hpp>
 
 class Component : public std::enable_shared_from_this<Component> {
 public:
-    entt::entity owner_entity;  // The entity this component belongs to
+    entt::entity owner_entity = entt::null;  // The entity this component belongs to, null until attached
     entt::entity entity;        // The component's own entity ID
     sol::environment environment;  // Lua environment for scripting
 
@@ -27,4 +30,20 @@ public:
 
     // Access Lua environment
     sol::environment& GetEnvironment();
+
+protected:
+    // Pooled environment of the given type; subclasses bind their methods when the slot is new
+    explicit Component(ObjectType type);
+
+    // Recycled with the environment; holds the bound methods
+    EnvironmentSlot* environment_slot = nullptr;
+
+    // Owner of a slot's bound methods; throws once the component has been destroyed
+    template <typename T>
+    static T& FromSlot(const EnvironmentSlot& slot) {
+        if (!slot.instance) {
+            throw sol::error("Component has been destroyed");
+        }
+        return static_cast<T&>(*static_cast<Component*>(slot.instance));
+    }
 };
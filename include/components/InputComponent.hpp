@@ -2,14 +2,30 @@
 
 #include "Component.hpp"
 #include <SDL2/SDL.h>
+#include <bitset>
 #include <unordered_map>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <LuaManager.hpp>
 
+// Actions are compiled when registered: each gets an integer id indexing a list of the
+// scancodes bound to it, so checking one is a few bit tests against a keyboard snapshot.
 class InputComponent : public Component {
 public:
-    std::unordered_map<int, std::unordered_map<uint32_t, std::string>> key_bindings; // Key -> {EventType -> Action} map
+    struct ActionTrigger {
+        SDL_Scancode scancode;
+        uint32_t event_type; // SDL_KEYDOWN or SDL_KEYUP
+    };
+
+    struct ActionBinding {
+        std::string name;
+        std::vector<SDL_Scancode> scancodes; // Distinct keys, for strength queries
+        std::vector<ActionTrigger> triggers; // Key events that fire the action, for InputSystem
+    };
+
+    std::vector<ActionBinding> actions;              // Indexed by action id
+    std::unordered_map<std::string, int> action_ids; // Action name -> id
 
     explicit InputComponent();
     ~InputComponent() override;
@@ -17,11 +33,27 @@ public:
     // Register key bindings for actions
     sol::environment RegisterAction(const std::string& action, const std::string& key_name, const std::string& event_type);
 
-    // Check action state
-    float GetActionStrength(const std::string& action);
+    // Id of a registered action, or -1
+    int GetActionId(const std::string& action) const;
+
+    // Check action state against the current keyboard snapshot
+    float GetActionStrength(int action_id) const;
+    float GetActionStrength(const std::string& action) const;
+
+    // Copy SDL's keyboard state; main thread, once per frame before input is dispatched
+    static void SnapshotKeyboard();
+    static bool IsScancodeDown(SDL_Scancode scancode);
+
+    // The snapshot as a whole, for InputRecorder to save and restore
+    static const std::bitset<SDL_NUM_SCANCODES>& GetKeyboardState();
+    static void SetKeyboardState(const std::bitset<SDL_NUM_SCANCODES>& state);
+
+    // Bumped whenever any component's bindings or owner change, so InputSystem knows to rebuild its routes
+    static uint64_t GetBindingsVersion();
 
     // Check if an action is triggered by an event
     bool IsActionTriggered(const sol::table& event_table, const sol::table& action_table);
+    bool IsActionTriggered(const sol::table& event_table, int action_id) const;
 
     // Bind Lua functionality
     static void Register();
@@ -30,6 +62,9 @@ public:
     void Emplace(entt::entity owner) override;
 
 private:
+    static std::bitset<SDL_NUM_SCANCODES> keyboard_state;
+    static uint64_t bindings_version;
+
     // Initialize Lua bindings
     void InitializeLuaBindings();
 };
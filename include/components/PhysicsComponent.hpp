@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Component.hpp"
+#include <Physics2D.hpp>
+#include <Transform2D.hpp>
+#include <RegistryManager.hpp>
+#include <LuaManager.hpp>
+#include <stdexcept>
+#include <iostream>
+
+// Lua handle for a RigidBody2D; the body itself lives on the owner and is stepped by PhysicsSystem
+class PhysicsComponent : public Component {
+public:
+    explicit PhysicsComponent(float mass = 1.0f, bool use_gravity = true);
+    ~PhysicsComponent() override;
+
+    void Emplace(entt::entity owner) override;
+
+    static void Register();
+
+    // The owner's body once emplaced, otherwise the settings it will start with
+    RigidBody2D& GetBody();
+
+private:
+    RigidBody2D initial_body;
+    RigidBody2D* body = nullptr; // Lives in the registry; stable for the owner's lifetime
+
+    void InitializeLuaBindings();
+};
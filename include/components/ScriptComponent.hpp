@@ -25,6 +25,9 @@ public:
     // Get the Lua environment for a specific script
     sol::environment GetScriptEnvironment(const std::string& scriptPath);
 
+    // Re-run a loaded script in its existing environment, keeping its state (hot reload)
+    void ReloadScript(const std::string& scriptPath);
+
     // List all loaded scripts (return paths as a table to Lua)
     std::vector<std::string> ListScripts() const;
 
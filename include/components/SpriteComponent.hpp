@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Component.hpp"
+#include <RenderCommandList.hpp>
+#include <TextureCache.hpp>
 #include <LuaManager.hpp>
 #include <RegistryManager.hpp>
 #include <SDL2/SDL.h>
@@ -12,8 +14,10 @@
 class SpriteComponent : public Component {
 public:
     std::string texturePath; // Path to the sprite texture
-    std::string currentTexturePath; // Current texture path
-    SDL_Texture* texture = nullptr; // Loaded SDL texture
+    std::string currentTexturePath; // Path of the texture currently held from the cache
+    const CachedTexture* texture = nullptr; // Shared entry owned by TextureCache
+    int texture_width = 0;   // Cached texture width, 0 until decoded
+    int texture_height = 0;  // Cached texture height
     int hframes = 1;         // Number of horizontal frames
     int vframes = 1;         // Number of vertical frames
     int frame = 0;           // Current frame index
@@ -24,8 +28,20 @@ public:
     explicit SpriteComponent(const std::string& path = "");
     ~SpriteComponent() override;
 
-    // Load the texture
-    void LoadTexture(const std::string& path, SDL_Renderer* renderer);
+    // Size drawn while the texture is still decoding
+    static constexpr int placeholder_size = 32;
+
+    // Acquire the texture from the shared cache; it decodes in the background
+    void LoadTexture(const std::string& path);
+
+    // Pick up the texture size once it is decoded; false while it is still unknown
+    bool RefreshTextureSize();
+
+    // Return the held texture to the shared cache
+    void ReleaseTexture();
+
+    // Whether the held texture matches texturePath, so frame_coords reflects what will be drawn
+    bool HasCurrentTexture() const;
 
     // Set the frame and update frame coordinates
     void SetFrame(int f);
@@ -33,8 +49,8 @@ public:
     // Update frame coordinates based on the texture size
     void UpdateFrameCoords();
 
-    // Render the sprite
-    void Render(SDL_Renderer* renderer, int x, int y);
+    // Append the sprite's quad to the frame's command list, centered on (x, y)
+    void Render(RenderCommandList& commands, int x, int y);
 
     void Emplace(entt::entity owner) override;
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <sol/sol.hpp>
+#include <cstdint>
+
+// Allocation counts for benchmarks. Lua allocations are counted by wrapping a state's
+// allocator while installed. Heap allocations need a build with ROGUE_COUNT_ALLOCATIONS,
+// which replaces the global operator new; other builds keep the default allocator.
+class AllocationCounter {
+public:
+#ifdef ROGUE_COUNT_ALLOCATIONS
+    static constexpr bool counts_heap = true;
+#else
+    static constexpr bool counts_heap = false;
+#endif
+
+    // Calls to the replaced operator new forms since startup; always 0 without counts_heap
+    static uint64_t GetHeapAllocations();
+
+    // Count new blocks and growing reallocations made by L until uninstalled
+    static void InstallLuaCounter(lua_State* L);
+    static void UninstallLuaCounter(lua_State* L);
+
+    // Lua allocations counted while installed
+    static uint64_t GetLuaAllocations();
+
+    // Deleted constructors to prevent instantiation
+    AllocationCounter() = delete;
+    ~AllocationCounter() = delete;
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <LuaManager.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+
+// Read-only packed asset archives, memory-mapped so reads come straight from the mapping.
+// Layout (little-endian):
+//   header  "RGPK", version, entry count, reserved, index offset, index size
+//   blobs   one per file, each aligned to blob_alignment, stored raw or LZ4-block compressed
+//   index   per entry: path length, flags, offset, stored size, size, path bytes
+// Archives are mounted at startup; lookups are then safe from any thread. Paths that no
+// archive contains fall back to loose files, so development runs need no archive.
+class AssetArchive {
+public:
+    static AssetArchive& GetInstance();
+
+    // Map an archive; entries override ones with the same path from earlier mounts.
+    // Mount before any loading starts.
+    bool Mount(const std::string& path);
+    void UnmountAll();
+
+    bool Contains(const std::string& path) const;
+
+    // Bytes of an entry: a view into the mapping, or into a buffer decompressed once.
+    // False when no mounted archive has path.
+    bool Read(const std::string& path, std::string_view& data);
+
+    // Read-only SDL stream over an entry, or over the loose file if no archive has it.
+    // Returns nullptr if neither exists; the caller closes it.
+    SDL_RWops* Open(const std::string& path);
+
+    size_t GetEntryCount() const;
+
+    // Offline tool: `Rogue --pack-assets <output> [--lz4] <dir>...`. Returns the process exit code.
+    static int Build(const std::string& output, const std::vector<std::string>& roots, bool compress);
+
+    // Register the Assets table in Lua
+    static void Register();
+
+    static constexpr uint32_t magic = 0x4B504752; // "RGPK"
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t flag_lz4 = 1;
+    static constexpr uint64_t blob_alignment = 16;
+
+private:
+    struct MappedFile;
+
+    struct Entry {
+        const uint8_t* data;   // Into the mapping
+        uint64_t stored_size;
+        uint64_t size;
+        uint32_t flags;
+    };
+
+    std::vector<std::unique_ptr<MappedFile>> mappings;
+    std::unordered_map<std::string, Entry> entries; // Keyed by normalized path
+
+    // Decompressed copies of LZ4 entries, filled on first read
+    std::mutex decompressed_mutex;
+    std::unordered_map<std::string, std::vector<uint8_t>> decompressed;
+
+    AssetArchive();
+    ~AssetArchive();
+
+    // Disallow copying and moving
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+    AssetArchive(AssetArchive&&) = delete;
+    AssetArchive& operator=(AssetArchive&&) = delete;
+};
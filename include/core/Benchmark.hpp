@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+// Named micro-benchmarks, run with `Rogue --benchmark <name> [count]`.
+// Each benchmark prints one JSON object to stdout.
+class Benchmark {
+public:
+    using Function = std::function<void(int count)>;
+
+    // Run a benchmark by name; returns the process exit code
+    static int Run(const std::string& name, int count);
+
+    // Print the names of every registered benchmark
+    static void List();
+
+    // Milliseconds spent running fn
+    template <typename Fn>
+    static double TimeMs(Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+private:
+    static const std::map<std::string, std::pair<int, Function>>& GetBenchmarks();
+};
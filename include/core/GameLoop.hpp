@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+struct GameLoopSettings {
+    float fixed_step = 1.0f / 60.0f;  // Simulation step in seconds
+    int max_steps_per_frame = 5;      // Catch-up cap; time beyond it is dropped
+    int target_fps = 60;              // Render rate cap (0 = uncapped)
+    bool spin_wait = false;           // Busy-wait the end of each frame for precise pacing
+    float spin_threshold = 0.002f;    // Seconds before the deadline to stop sleeping and spin
+    bool lockstep = false;            // Exactly one step per frame, ignoring wall-clock time (headless runs)
+};
+
+// Fixed-timestep simulation with a variable render rate.
+// Simulation runs in fixed_step increments from an accumulator; rendering
+// receives the leftover fraction of a step as an interpolation alpha.
+class GameLoop {
+public:
+    using InputFunction = std::function<bool()>;                       // Return false to quit
+    using UpdateFunction = std::function<void(float step)>;
+    using RenderFunction = std::function<void(float alpha, float frame_time)>;
+    using StepCountFunction = std::function<int()>;                    // Steps to run this frame
+
+    explicit GameLoop(const GameLoopSettings& settings = GameLoopSettings());
+
+    // Run until input returns false or Stop is called
+    void Run(const InputFunction& input, const UpdateFunction& update, const RenderFunction& render);
+
+    void Stop();
+
+    // Run exactly the returned number of steps each frame, after input, ignoring the clock
+    // (replaying recorded input). Pass an empty function to go back to the accumulator.
+    void SetStepCount(StepCountFunction step_count);
+
+    uint64_t GetSimulatedFrames() const;
+    uint64_t GetRenderedFrames() const;
+    double GetDroppedTime() const;  // Seconds discarded by the catch-up cap
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    GameLoopSettings settings;
+    bool running = false;
+    uint64_t simulated_frames = 0;
+    uint64_t rendered_frames = 0;
+    double dropped_time = 0.0;
+    StepCountFunction step_count;
+
+    void WaitUntil(Clock::time_point deadline) const;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iostream>
+
+class InputSystem;
+
+// Records the input each frame hands to scripts, and replays it so a session can be re-run
+// exactly (e.g. headless, across builds). A frame stores how many simulation steps followed it,
+// the keys held when the keyboard changed (which determines every action's strength) and the
+// key, mouse, text and quit events with their SDL timestamps. Other events aren't recorded.
+// Layout (little-endian): "RGIN", version u32, fixed step f32, then per frame
+//   varint steps, u8 flags (1 = keyboard changed, 2 = has events),
+//   [varint key count, varint scancodes...], [varint event count, events...]
+// where each event is varint type, varint timestamp and a type-specific payload.
+class InputRecorder {
+public:
+    static InputRecorder& GetInstance();
+
+    bool StartRecording(const std::string& path, float fixed_step);
+    bool StartReplay(const std::string& path, float fixed_step);
+
+    // Finish the last recorded frame (simulated_frames is the loop's final count) and close the file
+    void Stop(uint64_t simulated_frames);
+
+    bool IsRecording() const;
+    bool IsReplaying() const;
+
+    // Main thread, after InputSystem::Collect: save this frame's input. simulated_frames is the
+    // loop's count so far, which tells how many steps the previous frame ran.
+    void RecordFrame(const InputSystem& input, uint64_t simulated_frames);
+
+    // Replace this frame's events and keyboard snapshot with the next recorded frame.
+    // False once the recording is exhausted.
+    bool ReplayFrame(InputSystem& input);
+
+    // Steps the replayed frame must simulate (for GameLoop::SetStepCount)
+    int GetReplaySteps() const;
+
+    uint64_t GetFrameCount() const;
+
+    static constexpr uint32_t magic = 0x4E494752; // "RGIN"
+    static constexpr uint32_t version = 1;
+
+private:
+    enum class Mode { Idle, Recording, Replaying };
+
+    Mode mode = Mode::Idle;
+    std::string path;
+    uint64_t frames = 0;
+
+    // Recording: the frame is written once the next one reveals its step count
+    std::ofstream output;
+    bool has_pending = false;
+    uint64_t pending_tick = 0;
+    std::vector<uint8_t> pending;      // Encoded frame body, without the step count
+    std::bitset<SDL_NUM_SCANCODES> recorded_keys;
+
+    // Replaying: the whole file, read up front
+    std::vector<uint8_t> data;
+    size_t offset = 0;
+    int replay_steps = 0;
+    std::bitset<SDL_NUM_SCANCODES> replay_keys;
+
+    void FlushPending(uint64_t simulated_frames);
+
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    // Disallow copying and moving
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+    InputRecorder(InputRecorder&&) = delete;
+    InputRecorder& operator=(InputRecorder&&) = delete;
+};
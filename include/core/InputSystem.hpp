@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <RegistryManager.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <iostream>
+
+// Collects each frame's SDL events once and delivers them to the Objects that asked for input,
+// instead of walking the whole tree per event. Objects subscribe by defining process_input
+// (raw events) or process_action (action id, pressed); key events are translated to actions
+// through every InputComponent's compiled bindings and sent to the component's owner.
+// Subscribers are called in subscription order, whether or not they're attached to the root.
+class InputSystem {
+public:
+    static InputSystem& GetInstance();
+
+    // Pump SDL, snapshot the keyboard and buffer every pending event; main thread, once per frame
+    void Collect();
+
+    // Events buffered for this frame
+    const std::vector<SDL_Event>& GetEvents() const;
+
+    // Replace or extend the buffer without SDL (benchmarks, replays)
+    void ClearEvents();
+    void PushEvent(const SDL_Event& event);
+
+    // Deliver the buffered events and the actions they trigger
+    void Dispatch();
+
+    // Called by Object when its input callbacks change; stale entries are dropped at dispatch
+    void Subscribe(entt::entity entity);
+
+    size_t GetSubscriberCount() const;
+
+private:
+    struct ActionRoute {
+        entt::entity owner;
+        int action_id;
+        uint32_t event_type; // SDL_KEYDOWN or SDL_KEYUP
+    };
+
+    std::vector<SDL_Event> events;
+    std::vector<entt::entity> subscribers;     // In subscription order
+    std::unordered_set<entt::entity> subscribed;
+    std::vector<entt::entity> dispatch_list;   // Reused snapshot of subscribers
+
+    std::unordered_map<int, std::vector<ActionRoute>> routes; // Scancode -> actions it triggers
+    uint64_t routes_version = ~0ull;           // InputComponent::GetBindingsVersion() routes were built from
+
+    void RebuildRoutes();
+
+    InputSystem() = default;
+    ~InputSystem() = default;
+
+    // Disallow copying and moving
+    InputSystem(const InputSystem&) = delete;
+    InputSystem& operator=(const InputSystem&) = delete;
+    InputSystem(InputSystem&&) = delete;
+    InputSystem& operator=(InputSystem&&) = delete;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <entt/entt.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+struct Job;
+using JobHandle = Job*; // Valid until the next BeginFrame
+
+// One executed job in the frame trace
+struct JobTraceEvent {
+    const char* name;
+    int worker;        // 0 is the main thread
+    double start_us;   // Relative to BeginFrame
+    double end_us;
+};
+
+// Fixed pool of workers with one deque each. Workers pop their own newest job and steal
+// the oldest job of another worker when idle; the main thread is worker 0 and helps while
+// it waits. Jobs and their names must outlive the frame (names are string literals).
+class JobSystem {
+public:
+    static JobSystem& GetInstance();
+
+    // Start worker threads; 0 runs every job inline on the caller
+    void Initialize(int worker_count = -1);
+    void Shutdown();
+
+    // Wait for outstanding jobs, recycle job memory and start a new trace
+    void BeginFrame();
+
+    // Run task once every dependency has finished
+    JobHandle Schedule(const char* name, std::function<void()> task, std::initializer_list<JobHandle> dependencies = {});
+
+    // Block until job (and anything it spawned) finishes, running other jobs meanwhile
+    void Wait(JobHandle job);
+
+    // Split [0, count) into chunks of at most grain and run func(begin, end) on the pool
+    void ParallelFor(const char* name, size_t count, size_t grain, const std::function<void(size_t, size_t)>& func);
+
+    // ParallelFor over the entities of an entt view
+    template <typename View, typename Func>
+    void ParallelForEach(const char* name, const View& view, size_t grain, Func&& func) {
+        std::vector<entt::entity> entities(view.begin(), view.end());
+        ParallelFor(name, entities.size(), grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                func(entities[i]);
+            }
+        });
+    }
+
+    int GetWorkerCount() const;
+
+    // Jobs executed during the previous frame
+    const std::vector<JobTraceEvent>& GetLastFrameTrace() const;
+    void PrintTrace(std::ostream& out) const;
+
+    // Register the Jobs table in Lua
+    static void Register();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job*> jobs;
+        std::vector<JobTraceEvent> trace; // Only written by the owning worker
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // Index 0 is the main thread
+    std::vector<std::thread> workers;
+    std::mutex arena_mutex;
+    std::deque<Job> arena;                          // Stable addresses until BeginFrame
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<int> queued{0};                     // Jobs sitting in any queue
+    std::atomic<int> in_flight{0};                  // Jobs scheduled but not finished
+    std::atomic<bool> running{false};
+    std::chrono::steady_clock::time_point frame_start;
+    std::vector<JobTraceEvent> last_frame_trace;
+
+    JobSystem();
+    ~JobSystem();
+
+    Job* Allocate(const char* name, std::function<void()> task, Job* parent);
+    void Enqueue(Job* job);
+    Job* Pop(int worker);
+    bool RunOne(int worker);
+    void Finish(Job* job);
+    void WorkerLoop(int worker);
+
+    // Disallow copying and moving
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <iostream>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+};
+
+enum class LogCategory : uint8_t {
+    General,
+    Lifecycle, // Object and component creation, destruction and parenting
+    Script,
+    Assets,
+    Count,
+};
+
+// Lowest level compiled in; calls below it are removed entirely. Release builds drop Debug.
+#ifndef ROGUE_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define ROGUE_LOG_MIN_LEVEL 1
+#else
+#define ROGUE_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// Asynchronous logger. Callers format their message and push it onto a lock-free MPSC queue;
+// a background thread drains the queue in batches, Debug/Info to stdout and Warning/Error to
+// stderr, so logging never blocks on the console. Messages from one thread keep their order.
+// Errors wake the writer immediately; everything else is written within a few milliseconds.
+class Logger {
+public:
+    static Logger& GetInstance();
+
+    static constexpr LogLevel compiled_level = static_cast<LogLevel>(ROGUE_LOG_MIN_LEVEL);
+
+    template <typename... Args>
+    static void Debug(LogCategory category, const Args&... args) {
+        Write<LogLevel::Debug>(category, args...);
+    }
+
+    template <typename... Args>
+    static void Info(LogCategory category, const Args&... args) {
+        Write<LogLevel::Info>(category, args...);
+    }
+
+    template <typename... Args>
+    static void Warning(LogCategory category, const Args&... args) {
+        Write<LogLevel::Warning>(category, args...);
+    }
+
+    template <typename... Args>
+    static void Error(LogCategory category, const Args&... args) {
+        Write<LogLevel::Error>(category, args...);
+    }
+
+    bool IsEnabled(LogLevel level, LogCategory category) const {
+        return level >= min_level.load(std::memory_order_relaxed) &&
+               (category_mask.load(std::memory_order_relaxed) & (1u << static_cast<uint32_t>(category))) != 0;
+    }
+
+    void SetLevel(LogLevel level);
+    void SetCategoryEnabled(LogCategory category, bool enabled);
+
+    static bool ParseLevel(const std::string& name, LogLevel& level);
+    static bool ParseCategory(const std::string& name, LogCategory& category);
+
+    // Block until everything logged so far is written
+    void Flush();
+
+    // Drain and stop the writer thread; later messages are written synchronously
+    void Shutdown();
+
+    // Register the Log table in Lua
+    static void Register();
+
+private:
+    struct Message {
+        std::atomic<Message*> next{nullptr};
+        LogLevel level = LogLevel::Info;
+        std::string text;
+    };
+
+    std::atomic<LogLevel> min_level{compiled_level};
+    std::atomic<uint32_t> category_mask{~0u};
+
+    // Intrusive MPSC queue: producers swap themselves in at head, the writer pops from tail
+    std::atomic<Message*> head;
+    Message* tail;
+    Message stub;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> wake_requested{false};
+    std::atomic<uint64_t> enqueued{0};
+    uint64_t written = 0; // Guarded by mutex
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::thread writer;
+
+    template <LogLevel level, typename... Args>
+    static void Write(LogCategory category, const Args&... args) {
+        if constexpr (level >= compiled_level) {
+            Logger& logger = GetInstance();
+            if (!logger.IsEnabled(level, category)) {
+                return;
+            }
+            std::string text;
+            (Append(text, args), ...);
+            logger.Enqueue(level, std::move(text));
+        }
+    }
+
+    template <typename T>
+    static void Append(std::string& text, const T& value) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            text.append(std::string_view(value));
+        } else if constexpr (std::is_same_v<T, char>) {
+            text.push_back(value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            text.append(value ? "true" : "false");
+        } else if constexpr (std::is_integral_v<T>) {
+            text.append(std::to_string(value));
+        } else {
+            std::ostringstream stream;
+            stream << value;
+            text.append(stream.str());
+        }
+    }
+
+    void Enqueue(LogLevel level, std::string text);
+    void Push(Message* message);
+    Message* Pop();
+    void WriterLoop();
+    size_t Drain();
+
+    Logger();
+    ~Logger();
+
+    // Disallow copying and moving
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+    Logger(Logger&&) = delete;
+    Logger& operator=(Logger&&) = delete;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <entt/entt.hpp>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <iostream>
+
+// Sampling profiler for Lua. A count hook fires every few VM instructions and charges the Lua
+// time since the previous sample to the current call stack once a sample period has passed.
+// Only time inside a Scope counts, so native work between callbacks isn't blamed on scripts;
+// the engine opens a Scope around every callback it makes into an Object's or component's
+// script, which also attributes the time to that entity. Main thread only.
+class LuaProfiler {
+public:
+    static LuaProfiler& GetInstance();
+
+    // Coroutines created before Start aren't sampled
+    void Start(double period_us = 1000.0, int instruction_interval = 100);
+    void Stop();
+    bool IsRunning() const;
+
+    // Forget every sample
+    void Clear();
+
+    // Folded stacks for flamegraph.pl / speedscope: "entity 3;scripts/player.lua:update:12 <us>"
+    void WriteFolded(std::ostream& out) const;
+    bool WriteFolded(const std::string& path) const;
+
+    // Self time by function, chunk and entity, most expensive first
+    void PrintReport(std::ostream& out, size_t limit = 15) const;
+
+    // Register the LuaProfiler table in Lua
+    static void Register();
+
+    // Lua called while a Scope is open is charged to entity
+    class Scope {
+    public:
+        explicit Scope(entt::entity entity);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        entt::entity previous;
+    };
+
+    static constexpr int max_stack_depth = 64;
+
+private:
+    bool running = false;
+    std::chrono::nanoseconds period{1000000};
+    int scope_depth = 0;
+    entt::entity current_entity = entt::null;
+    std::chrono::steady_clock::time_point segment_start; // Last time Lua time was accounted
+    std::chrono::nanoseconds pending{0};                 // Lua time not yet charged to a sample
+
+    uint64_t samples = 0;
+    std::unordered_map<std::string, uint64_t> stack_ns;    // Folded stack -> time
+    std::unordered_map<std::string, uint64_t> function_ns; // Innermost frame -> self time
+    std::unordered_map<std::string, uint64_t> chunk_ns;    // Innermost frame's chunk -> self time
+    std::unordered_map<uint32_t, uint64_t> entity_ns;      // Entity -> total time
+
+    static void Hook(lua_State* L, lua_Debug* ar);
+    void Sample(lua_State* L, uint64_t weight_ns);
+
+    LuaProfiler() = default;
+    ~LuaProfiler() = default;
+
+    // Disallow copying and moving
+    LuaProfiler(const LuaProfiler&) = delete;
+    LuaProfiler& operator=(const LuaProfiler&) = delete;
+    LuaProfiler(LuaProfiler&&) = delete;
+    LuaProfiler& operator=(LuaProfiler&&) = delete;
+};
@@ -9,15 +9,19 @@
 #include <SDL2/SDL.h>
 #include <RegistryManager.hpp>
 #include <LuaManager.hpp>
+#include <EnvironmentPool.hpp>
+#include <ObjectPool.hpp>
 #include <Component.hpp>
+#include <ObjectType.hpp>
 
 class Object : public std::enable_shared_from_this<Object> {
 public:
-    entt::entity parent_entity;
+    entt::entity parent_entity = entt::null;
     entt::entity entity;
     sol::environment environment;
     std::vector<entt::entity> children;
     std::vector<entt::entity> components;
+    std::string script_path; // File last run by SetScript
 
     explicit Object();
 
@@ -28,17 +32,63 @@ public:
     Object(Object&&) = delete;
     Object& operator=(Object&&) = delete;
 
-    virtual ~Object() = default;
+    virtual ~Object();
 
     // Register the Object class in Lua
     static void Register();
 
     virtual void SetScript(const std::string& file_path);
+
+    // Re-run script_path in the existing environment, keeping its state (hot reload)
+    virtual void ReloadScript();
     virtual void Process(float delta);
+    // Legacy tree walk: deliver event to this Object and every descendant
     virtual void ProcessInput(const SDL_Event& event);
+
+    // Run this Object's own input callbacks; InputSystem calls these for subscribers only
+    void HandleInput(const SDL_Event& event);
+    void HandleAction(int action_id, bool pressed);
+    bool HandlesInput() const;
     void AddChild(entt::entity child_entity);
     void AddComponent(entt::entity component_entity);
 
+    // Destroy this Object, its children and its components immediately
+    void Destroy();
+
+    // Destroy at the end of the current step (safe to call from Lua process)
+    void QueueFree();
+
+    // Destroy every Object queued with QueueFree
+    static void DestroyQueued();
+
     // Retrieve the Lua environment for this Object
     sol::environment& GetEnvironment();
+
+protected:
+    // Pooled environment of the given type; subclasses bind their methods when the slot is new
+    explicit Object(ObjectType type);
+
+    // Lifecycle callbacks resolved once, refreshed whenever the script assigns them
+    sol::protected_function process_callback;
+    sol::protected_function process_input_callback;
+    sol::protected_function process_action_callback;
+
+    // Recycled with the environment: bound methods, and the callbacks table that keeps
+    // lifecycle callbacks outside the environment so every assignment hits __newindex
+    EnvironmentSlot* environment_slot = nullptr;
+
+    // Owner of a slot's bound methods; throws once the Object has been destroyed
+    template <typename T = Object>
+    static T& FromSlot(const EnvironmentSlot& slot) {
+        if (!slot.instance) {
+            throw sol::error("Object has been destroyed");
+        }
+        return static_cast<T&>(*static_cast<Object*>(slot.instance));
+    }
+
+private:
+    void BindMethods();
+    void ResolveLifecycleCallbacks();
+    void UpdateInputSubscription();
+    static void OnEnvironmentAssign(sol::table env, sol::object key, sol::object value);
 };
@@ -2,6 +2,8 @@
 
 #include <Object.hpp>
 #include <Vector2.hpp>
+#include <Transform2D.hpp>
+#include <TransformSystem.hpp>
 #include <LuaManager.hpp>
 #include <RegistryManager.hpp>
 #include <memory>
@@ -9,31 +11,30 @@
 
 class Object2D : public Object {
 public:
-    Vector2 position;         // Local position
-    Vector2 global_position;  // Global position
+    Transform2D* transform; // Lives in the registry; stable for the entity's lifetime
 
     explicit Object2D();
     ~Object2D() override = default;
 
     static void Register();
 
-    void Process(float delta) override;
-
     void SetPosition(float x, float y);
     Vector2 GetPosition();
 
     void SetGlobalPosition(float x, float y);
     Vector2 GetGlobalPosition();
 
+    // Global position blended between the last two simulation steps (alpha in [0, 1])
+    Vector2 GetInterpolatedPosition(float alpha);
+
+    void SetRotation(float degrees);
+    float GetRotation() const;
+
+    void SetScale(float x, float y);
+    Vector2 GetScale() const;
+
     void SetParent(entt::entity parent_entity_ref);
     entt::entity GetParent() const;
 
     static std::shared_ptr<Object2D> Create();
-
-private:
-    void UpdateGlobalPosition();
-    void UpdateLocalPosition();
-
-    bool position_dirty;         // Tracks changes in local position
-    bool global_position_dirty;  // Tracks changes in global position
 };
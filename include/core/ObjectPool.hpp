@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Counters shared by every block pool
+struct ObjectPoolStats {
+    size_t chunk_allocations = 0; // Heap allocations made to grow a pool
+    size_t allocations = 0;       // Blocks handed out
+    size_t reuses = 0;            // Blocks handed out that had been released before
+    size_t live = 0;              // Blocks currently in use
+};
+
+inline ObjectPoolStats& GetObjectPoolStats() {
+    static ObjectPoolStats stats;
+    return stats;
+}
+
+// Fixed-size blocks carved from chunks and recycled through an intrusive free list.
+// Not thread-safe: objects are spawned and destroyed on the main thread.
+class BlockPool {
+public:
+    explicit BlockPool(size_t block_size, size_t blocks_per_chunk = 64)
+        : block_size(RoundUp(block_size < sizeof(FreeNode) ? sizeof(FreeNode) : block_size)),
+          blocks_per_chunk(blocks_per_chunk) {}
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    void* Allocate() {
+        ObjectPoolStats& stats = GetObjectPoolStats();
+        if (!free_list) {
+            Grow();
+        } else if (free_list->recycled) {
+            ++stats.reuses;
+        }
+
+        FreeNode* node = free_list;
+        free_list = node->next;
+        ++stats.allocations;
+        ++stats.live;
+        return node;
+    }
+
+    void Deallocate(void* block) {
+        FreeNode* node = static_cast<FreeNode*>(block);
+        node->next = free_list;
+        node->recycled = true;
+        free_list = node;
+        --GetObjectPoolStats().live;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+        bool recycled;
+    };
+
+    size_t block_size;
+    size_t blocks_per_chunk;
+    FreeNode* free_list = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+
+    static size_t RoundUp(size_t size) {
+        constexpr size_t align = alignof(std::max_align_t);
+        return (size + align - 1) / align * align;
+    }
+
+    void Grow() {
+        chunks.emplace_back(new std::byte[block_size * blocks_per_chunk]);
+        ++GetObjectPoolStats().chunk_allocations;
+        std::byte* chunk = chunks.back().get();
+        for (size_t i = blocks_per_chunk; i-- > 0;) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * block_size);
+            node->next = free_list;
+            node->recycled = false;
+            free_list = node;
+        }
+    }
+};
+
+// One pool per block size, shared by every type that rebinds to it
+template <size_t Size>
+BlockPool& GetBlockPool() {
+    static BlockPool pool(Size);
+    return pool;
+}
+
+// Allocator that routes single-object allocations (e.g. allocate_shared's
+// combined control block + object) to a fixed-size BlockPool
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(GetBlockPool<sizeof(T)>().Allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t n) noexcept {
+        if (n == 1) {
+            GetBlockPool<sizeof(T)>().Deallocate(block);
+            return;
+        }
+        ::operator delete(block);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+// Pooled replacement for std::make_shared
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooled(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Compact type id stored on every Object and Component entity
+enum class ObjectType : uint8_t {
+    Object,
+    Object2D,
+    Component,
+    SpriteComponent,
+    InputComponent,
+    ScriptComponent,
+    CameraComponent,
+    PhysicsComponent,
+    ColliderComponent,
+};
+
+// Empty tag so systems can view Object2D entities without comparing type ids
+struct Object2DTag {};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Vector2.hpp>
+#include <cstdint>
+
+enum class ColliderShape : uint8_t {
+    Box,    // size is the full width and height
+    Circle, // size.x is the diameter
+};
+
+// Simulation state of a physics body, stored on the owning Object2D's entity
+struct RigidBody2D {
+    static constexpr bool in_place_delete = true;
+
+    Vector2 velocity;                 // Pixels per second
+    float mass = 1.0f;                // <= 0 makes the body static
+    float gravity_scale = 1.0f;       // Multiplies the global gravity
+    float drag = 1.0f;                // Multiplies the global drag
+    bool use_gravity = true;
+
+    // Contact from the last step
+    bool colliding = false;
+    Vector2 collision_normal;
+};
+
+// Collision shape, stored on the owning Object2D's entity and centered on its global position + offset
+struct Collider2D {
+    static constexpr bool in_place_delete = true;
+
+    ColliderShape shape = ColliderShape::Box;
+    Vector2 size;
+    Vector2 offset;
+    bool enabled = true;
+
+    Vector2 GetHalfExtents() const {
+        if (shape == ColliderShape::Circle) {
+            return Vector2(size.x * 0.5f, size.x * 0.5f);
+        }
+        return Vector2::Abs(size) * 0.5f;
+    }
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Physics2D.hpp>
+#include <Transform2D.hpp>
+#include <RegistryManager.hpp>
+#include <LuaManager.hpp>
+#include <vector>
+#include <iostream>
+
+// World-wide settings, set from Lua through the tree table
+struct PhysicsSettings {
+    Vector2 gravity;                  // Global gravity acceleration
+    float drag = 0.0f;                // Global linear drag, per second
+    float gravity_scale = 1.0f;
+    float drag_scale = 1.0f;
+    int max_iterations = 4;           // Slides per body and step
+};
+
+struct PhysicsStats {
+    size_t bodies = 0;                // Dynamic bodies integrated during the last step
+    size_t contacts = 0;              // Sweeps that hit a collider during the last step
+};
+
+// Integrates every RigidBody2D at the fixed simulation step and resolves collisions by
+// sweeping its collider's AABB against nearby colliders found through SpatialHash2D.
+// Circles are swept as their bounding boxes; other bodies are treated as fixed during a sweep.
+class PhysicsSystem {
+public:
+    static PhysicsSystem& GetInstance();
+
+    // Advance all bodies by one fixed step; runs before TransformSystem::Update
+    void Step(float step);
+
+    PhysicsSettings& GetSettings();
+    const PhysicsStats& GetStats() const;
+
+    // Register the physics functions of the tree table in Lua
+    static void Register();
+
+private:
+    PhysicsSettings settings;
+    PhysicsStats stats;
+    std::vector<entt::entity> candidates; // Reused broadphase results
+
+    PhysicsSystem() = default;
+    ~PhysicsSystem() = default;
+
+    // Move a collider along motion, sliding along whatever it hits; returns the new global position
+    Vector2 Sweep(entt::entity entity, const Collider2D& collider, RigidBody2D& body, Vector2 position, Vector2 motion);
+
+    // Disallow copying and moving
+    PhysicsSystem(const PhysicsSystem&) = delete;
+    PhysicsSystem& operator=(const PhysicsSystem&) = delete;
+    PhysicsSystem(PhysicsSystem&&) = delete;
+    PhysicsSystem& operator=(PhysicsSystem&&) = delete;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <iostream>
+
+// One finished zone, as read back from a thread's ring buffer
+struct ProfileEvent {
+    const char* name;
+    uint32_t thread;
+    uint64_t start_ns; // Relative to the profiler's start
+    uint64_t end_ns;
+};
+
+// CPU zone profiler. Each thread records into its own fixed ring buffer, so recording takes
+// no locks: the owning thread fills a slot and then publishes it by bumping the head. Old
+// events are overwritten once a buffer wraps. Zone names must outlive the profiler (string
+// literals). Recording is off until SetEnabled(true); disabled zones cost one atomic load.
+class Profiler {
+public:
+    static Profiler& GetInstance();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Name the calling thread in exported traces
+    static void SetThreadName(const std::string& name);
+
+    // Record a zone measured elsewhere on the calling thread
+    void Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    // Copy of every buffered event, oldest first per thread. Safe while other threads record.
+    std::vector<ProfileEvent> Collect() const;
+
+    // Drop buffered events (each thread's buffer is cleared lazily)
+    void Clear();
+
+    // Chrome trace event JSON, readable by about:tracing and ui.perfetto.dev
+    void WriteChromeTrace(std::ostream& out) const;
+    bool WriteChromeTrace(const std::string& path) const;
+
+    // Register the Profiler table in Lua
+    static void Register();
+
+    static constexpr size_t events_per_thread = 1 << 16;
+
+private:
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start_ns{0};
+        std::atomic<uint64_t> end_ns{0};
+    };
+
+    struct ThreadBuffer {
+        uint32_t thread;
+        std::string name;
+        std::atomic<uint64_t> writing{0}; // Bumped before a slot is overwritten
+        std::atomic<uint64_t> head{0};    // Bumped once the slot is complete
+        std::atomic<uint64_t> tail{0};    // Events before this were cleared
+        std::array<Slot, events_per_thread> slots;
+    };
+
+    std::atomic<bool> enabled{false};
+    std::chrono::steady_clock::time_point epoch;
+
+    mutable std::mutex buffers_mutex; // Guards the list, not the buffers' contents
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    Profiler();
+
+    ThreadBuffer& GetThreadBuffer();
+
+    // Disallow copying and moving
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+};
+
+// Records the enclosing scope as one zone on the calling thread
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name(name) {
+        if (Profiler::GetInstance().IsEnabled()) {
+            start = std::chrono::steady_clock::now();
+            active = true;
+        }
+    }
+
+    ~ProfileZone() {
+        if (active) {
+            Profiler::GetInstance().Record(name, start, std::chrono::steady_clock::now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+    bool active = false;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <unordered_map>
+#include <iostream>
+
+struct ScriptCacheStats {
+    size_t compiles = 0;    // Scripts parsed from source
+    size_t disk_hits = 0;   // Scripts restored from the on-disk bytecode cache
+    size_t hits = 0;        // Runs served from memory without touching the file
+    size_t runs = 0;        // Scripts executed into an environment
+    size_t reloads = 0;     // Environments re-run by Reload
+};
+
+// Compiles each script file once and keeps its Lua bytecode, so spawning many objects
+// with the same script only undumps it instead of re-lexing and re-parsing the source.
+// Every run loads a fresh closure, so each environment gets its own _ENV upvalue.
+// Bytecode can optionally be persisted to disk, keyed by a hash of the source.
+class ScriptCache {
+public:
+    static ScriptCache& GetInstance();
+
+    // Run the script at path inside env. Throws sol::error on load or runtime errors.
+    void Run(const std::string& path, sol::environment& env);
+
+    // Re-run path into an environment that already ran it. Functions take the new definitions,
+    // while data the script had set up keeps its current value and tables keep their identity.
+    void Reload(const std::string& path, sol::environment& env);
+
+    // Recompile path from source; on a syntax error the previous bytecode is kept and false returned
+    bool Recompile(const std::string& path);
+
+    // Directory for persisted bytecode; empty disables the disk cache
+    void SetDiskCacheDirectory(const std::string& directory);
+    const std::string& GetDiskCacheDirectory() const;
+
+    // Forget the compiled bytecode for path, or for every script
+    void Invalidate(const std::string& path);
+    void Clear();
+
+    // Key scripts by a normal form, so "./scripts/a.lua" and "scripts/a.lua" share an entry
+    static std::string NormalizePath(const std::string& path);
+
+    size_t GetCachedCount() const;
+    const ScriptCacheStats& GetStats() const;
+
+    // Register the ScriptCache table in Lua
+    static void Register();
+
+private:
+    struct Entry {
+        uint64_t source_hash = 0;
+        std::string bytecode;
+    };
+
+    std::unordered_map<std::string, Entry> entries; // Keyed by NormalizePath
+    std::string disk_directory;
+    ScriptCacheStats stats;
+
+    ScriptCache() = default;
+    ~ScriptCache() = default;
+
+    // Compile path (or restore it from disk) into a new entry
+    const Entry& Compile(const std::string& path);
+
+    // Copy new functions into current and keep current data, recursing into tables both share
+    void MergeState(sol::table current, sol::table fresh, std::unordered_set<const void*>& visited);
+
+    // Disallow copying and moving
+    ScriptCache(const ScriptCache&) = delete;
+    ScriptCache& operator=(const ScriptCache&) = delete;
+    ScriptCache(ScriptCache&&) = delete;
+    ScriptCache& operator=(ScriptCache&&) = delete;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <LuaManager.hpp>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+
+// Watches script directories and hot-reloads changed .lua files: each file is recompiled once,
+// then re-run into every Object and ScriptComponent environment that loaded it, keeping state.
+// Uses inotify on Linux and polls modification times elsewhere.
+class ScriptWatcher {
+public:
+    static ScriptWatcher& GetInstance();
+
+    // Start watching directory and its subdirectories; false if it cannot be watched
+    bool Watch(const std::string& directory);
+    void Stop();
+    bool IsWatching() const;
+
+    // Main thread, once per frame: reload every script changed since the last call
+    void Poll();
+
+    // Recompile path and re-run it into every environment that loaded it; returns how many were reloaded.
+    // Components the re-run creates but never attaches are destroyed afterwards.
+    size_t Reload(const std::string& path);
+
+    // Register the ScriptWatcher table in Lua
+    static void Register();
+
+private:
+    std::vector<std::string> directories;
+
+#ifdef __linux__
+    int inotify_fd = -1;
+    std::unordered_map<int, std::string> watch_directories; // Watch descriptor -> directory
+
+    void AddWatch(const std::string& directory);
+#else
+    static constexpr std::chrono::milliseconds scan_interval{500};
+    std::chrono::steady_clock::time_point next_scan;
+    std::unordered_map<std::string, std::filesystem::file_time_type> write_times;
+#endif
+
+    // Append the .lua files changed since the last call
+    void CollectChanges(std::vector<std::string>& changed);
+
+    ScriptWatcher() = default;
+    ~ScriptWatcher();
+
+    // Disallow copying and moving
+    ScriptWatcher(const ScriptWatcher&) = delete;
+    ScriptWatcher& operator=(const ScriptWatcher&) = delete;
+    ScriptWatcher(ScriptWatcher&&) = delete;
+    ScriptWatcher& operator=(ScriptWatcher&&) = delete;
+};
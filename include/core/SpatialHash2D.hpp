@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Vector2.hpp>
+#include <Transform2D.hpp>
+#include <ObjectType.hpp>
+#include <RegistryManager.hpp>
+#include <LuaManager.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+
+// Per-entity broadphase entry, kept in the registry next to Transform2D
+struct SpatialProxy {
+    Vector2 half_extents;            // AABB half size around the global position (zero = point)
+    Vector2 min, max;                // World AABB as last inserted
+    int cell_min_x = 0, cell_min_y = 0;
+    int cell_max_x = -1, cell_max_y = -1; // Empty range until first inserted
+    uint32_t query_stamp = 0;        // Last query that visited this entry, to skip duplicates
+    bool extents_dirty = true;
+    bool oversized = false;          // Kept in the everywhere list instead of the cells it covers
+};
+
+struct RaycastHit {
+    entt::entity entity;
+    float distance;                  // Along the normalized ray direction
+};
+
+struct SpatialHashStats {
+    size_t tracked = 0;              // Entities in the grid
+    size_t cells = 0;                // Non-empty cells
+    size_t oversized = 0;            // Entities too large to bucket, checked by every query
+    size_t rebucketed = 0;           // Entities moved between cells during the last Update
+    size_t refreshed = 0;            // Entities whose AABB was recomputed during the last Update
+};
+
+// Uniform grid over Object2D global AABBs. Update runs after TransformSystem and only
+// touches entities whose transform changed; an entity is re-bucketed only when its
+// covered cell range changes. Entities covering more than max_proxy_cells cells go in a
+// list every query checks, and queries over more cells than are occupied scan the occupied ones.
+class SpatialHash2D {
+public:
+    static SpatialHash2D& GetInstance();
+
+    // Sync the grid with the transforms resolved this step
+    void Update();
+
+    // Size of the AABB tracked for an entity, centered on its global position
+    void SetExtents(entt::entity entity, const Vector2& half_extents);
+
+    // Change the cell size and re-bucket everything
+    void SetCellSize(float size);
+    float GetCellSize() const;
+
+    // Queries append matching entities to out (each entity at most once); non-finite input matches nothing
+    void QueryRadius(const Vector2& center, float radius, std::vector<entt::entity>& out);
+    void QueryAABB(const Vector2& min, const Vector2& max, std::vector<entt::entity>& out);
+
+    // Every AABB hit by the ray within max_distance, nearest first
+    void Raycast(const Vector2& origin, const Vector2& direction, float max_distance, std::vector<RaycastHit>& out);
+
+    // Drop every cell; entities are re-inserted on the next Update
+    void Clear();
+
+    const SpatialHashStats& GetStats() const;
+
+    // Register the SpatialHash table in Lua
+    static void Register();
+
+private:
+    using CellKey = uint64_t;
+
+    static constexpr int64_t max_proxy_cells = 1024;
+    static constexpr int cell_limit = 1 << 30;  // Cell coordinates are clamped to +-cell_limit
+
+    float cell_size = 64.0f;
+    float inv_cell_size = 1.0f / 64.0f;
+    std::unordered_map<CellKey, std::vector<entt::entity>> cells;
+    std::vector<entt::entity> oversized;      // Proxies spanning more than max_proxy_cells
+    uint32_t query_stamp = 0;
+    SpatialHashStats stats;
+
+    SpatialHash2D();
+    ~SpatialHash2D();
+
+    static CellKey MakeKey(int x, int y);
+    int ToCell(float coordinate) const;
+    static int64_t CellCount(int min_x, int min_y, int max_x, int max_y);
+
+    // Call visit with every non-empty bucket in the cell range
+    template <typename Visitor>
+    void VisitCells(int min_x, int min_y, int max_x, int max_y, Visitor&& visit);
+
+    void Insert(entt::entity entity, SpatialProxy& proxy);
+    void Remove(entt::entity entity, SpatialProxy& proxy);
+    void OnProxyDestroyed(entt::registry& registry, entt::entity entity);
+    uint32_t NextQueryStamp();
+
+    // Disallow copying and moving
+    SpatialHash2D(const SpatialHash2D&) = delete;
+    SpatialHash2D& operator=(const SpatialHash2D&) = delete;
+    SpatialHash2D(SpatialHash2D&&) = delete;
+    SpatialHash2D& operator=(SpatialHash2D&&) = delete;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Vector2.hpp>
+#include <entt/entt.hpp>
+
+// 2D transform stored contiguously in the registry and resolved by TransformSystem.
+// Lua holds references to these fields, so the storage must never relocate live elements.
+struct Transform2D {
+    static constexpr bool in_place_delete = true;
+
+    Vector2 position;                    // Local position
+    float rotation = 0.0f;               // Local rotation in degrees
+    Vector2 scale = {1.0f, 1.0f};        // Local scale
+
+    Vector2 global_position;             // World position
+    float global_rotation = 0.0f;        // World rotation in degrees
+    Vector2 global_scale = {1.0f, 1.0f}; // World scale
+    Vector2 previous_global_position;    // World position after the previous update, for interpolation
+
+    entt::entity parent = entt::null;    // Parent transform (null when the parent is not 2D)
+    bool dirty = true;                   // Local values changed since the last update
+    bool changed = false;                // World values changed during the last update
+    bool initialized = false;            // Set after the first update, so spawns don't interpolate from the origin
+
+    // Values seen by the last update, used to detect direct writes from Lua
+    Vector2 last_position;
+    Vector2 last_global_position;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Transform2D.hpp>
+#include <RegistryManager.hpp>
+#include <vector>
+#include <iostream>
+
+// Resolves every Transform2D once per simulation step, parents before children
+class TransformSystem {
+public:
+    static TransformSystem& GetInstance();
+
+    // Propagate local changes to world values for the whole hierarchy
+    void Update();
+
+    // Attach entity to parent (or detach with entt::null)
+    void SetParent(entt::entity entity, entt::entity parent);
+
+    // Immediate setters that keep the node itself consistent; descendants follow on the next Update
+    void SetPosition(entt::entity entity, const Vector2& position);
+    void SetGlobalPosition(entt::entity entity, const Vector2& global_position);
+
+    // Force the update order to be rebuilt
+    void MarkHierarchyDirty();
+
+private:
+    std::vector<entt::entity> update_order; // Sorted by depth so parents precede children
+    std::vector<size_t> level_starts;       // Offset of each depth in update_order, plus the end
+    bool hierarchy_dirty = true;
+
+    TransformSystem();
+    ~TransformSystem();
+
+    void OnTransformChanged(entt::registry& registry, entt::entity entity);
+    void RebuildOrder();
+
+    // Disallow copying and moving
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+    TransformSystem(TransformSystem&&) = delete;
+    TransformSystem& operator=(TransformSystem&&) = delete;
+};
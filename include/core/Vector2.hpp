@@ -2,15 +2,17 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <type_traits>
 #include <sol/sol.hpp>
+#include <LuaManager.hpp>
 
+// Plain 8-byte value type; Lua gets copies (or references bound explicitly with std::ref)
 struct Vector2 {
     float x, y;
 
     // Constructors
     Vector2() : x(0.0f), y(0.0f) {}
     Vector2(float x, float y) : x(x), y(y) {}
-    sol::userdata lua_instance; // Store the Lua instance
 
     // Friend Operator Overloads
     friend Vector2 operator+(const Vector2& lhs, const Vector2& rhs) {
@@ -178,26 +180,12 @@ struct Vector2 {
         return Vector2(std::clamp(vec.x, min.x, max.x), std::clamp(vec.y, min.y, max.y));
     }
 
-    void set_instance(const sol::userdata& instance) {
-        lua_instance = instance;
-    }
-
-    sol::userdata get_instance() const {
-        return lua_instance;
-    }
-
     // Lua Registration
     static void Register() {
         sol::state& lua = LuaManager::GetInstance();
         lua.new_usertype<Vector2>("Vector2",
             sol::constructors<Vector2(), Vector2(float, float)>(),
-            sol::call_constructor, [](sol::this_state ts, float x, float y) {
-                sol::state_view lua(ts);
-                sol::userdata instance = lua["Vector2"].call<sol::userdata>(x, y);
-                auto& obj = instance.as<Vector2>();
-                obj.set_instance(instance);
-                return obj;
-            },
+            sol::call_constructor, sol::constructors<Vector2(), Vector2(float, float)>(),
             "x", &Vector2::x,
             "y", &Vector2::y,
             "magnitude", &Vector2::Magnitude,
@@ -225,3 +213,7 @@ struct Vector2 {
         );
     }
 };
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must stay two packed floats");
+static_assert(std::is_trivially_copyable_v<Vector2>, "Vector2 must stay trivially copyable");
+static_assert(std::is_standard_layout_v<Vector2>, "Vector2 must stay standard layout");
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <AtlasPacker.hpp>
+#include <string>
+#include <vector>
+#include <iostream>
+
+// Offline atlas tool: `Rogue --pack-atlas <output.png> <image>...` packs the images into one
+// PNG and writes <output>.atlas next to it, which TextureCache::LoadAtlas reads at runtime.
+class AtlasBuilder {
+public:
+    // Returns the process exit code
+    static int Run(const std::string& output, const std::vector<std::string>& inputs);
+
+    static constexpr int padding = 1;
+    static constexpr int max_size = 8192;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Skyline bottom-left rectangle packer. Rectangles are placed where their top edge ends up
+// lowest, which keeps the free area in one band along the top of the skyline.
+// Space is never reclaimed; a page is dropped as a whole once nothing uses it.
+class AtlasPacker {
+public:
+    AtlasPacker(int width = 0, int height = 0);
+
+    // Forget every placement and start over with the given size
+    void Reset(int width, int height);
+
+    // Place a width x height rectangle; false when it doesn't fit
+    bool Insert(int width, int height, SDL_Rect& rect);
+
+    int GetWidth() const;
+    int GetHeight() const;
+
+    // Fraction of the area covered by placed rectangles
+    float GetOccupancy() const;
+
+private:
+    // Top edge of the used area over [x, x + width)
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    std::vector<Segment> skyline;
+    int width = 0;
+    int height = 0;
+    long long used_area = 0;
+
+    // Lowest y at which a rectangle starting at segment index fits, or -1
+    int Fit(size_t index, int rect_width, int rect_height) const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <Vector2.hpp>
+#include <TextureCache.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// One sprite quad in screen space
+struct SpriteCommand {
+    const CachedTexture* texture; // Resolved to an SDL_Texture on the render thread
+    SDL_Rect src;
+    SDL_FRect dest;
+    bool flip_h;
+    bool flip_v;
+};
+
+// Everything needed to draw one frame, built by the simulation and never modified once published
+struct RenderCommandList {
+    uint64_t generation = 0;              // TextureCache generation this list was built in
+    SDL_Color clear_color = {0, 0, 0, 255};
+    Vector2 camera_position;              // Top-left of the view in world space
+    float camera_zoom = 1.0f;
+    bool draw_placeholders = false;       // Draw a flat quad for sprites whose texture isn't uploaded yet
+    std::vector<SpriteCommand> sprites;   // Capacity is kept when the slot is reused
+
+    void Reset() {
+        sprites.clear();
+    }
+};
+
+// Lock-free triple buffer: the producer always has a slot to write, the consumer always
+// reads the newest published list, and neither ever waits on the other.
+class RenderCommandBuffer {
+public:
+    // Slot owned by the producer until Publish
+    RenderCommandList& GetWriteList() { return lists[write_index]; }
+
+    // Hand the written slot to the consumer and take the spare one
+    void Publish() {
+        write_index = middle.exchange(write_index | fresh_bit) & index_mask;
+    }
+
+    // Swap in the newest published list; false when nothing new was published
+    bool AcquireLatest() {
+        if (!(middle.load() & fresh_bit)) {
+            return false;
+        }
+        read_index = middle.exchange(read_index) & index_mask;
+        return true;
+    }
+
+    // Slot owned by the consumer until the next AcquireLatest
+    const RenderCommandList& GetReadList() const { return lists[read_index]; }
+
+private:
+    static constexpr uint8_t index_mask = 0x3;
+    static constexpr uint8_t fresh_bit = 0x4;
+
+    std::array<RenderCommandList, 3> lists;
+    uint8_t write_index = 0;
+    std::atomic<uint8_t> middle{1};
+    uint8_t read_index = 2;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <RenderCommandList.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <iostream>
+
+// Owns the SDL renderer on a dedicated thread and draws the newest published command list,
+// so the simulation can build frame N+1 while frame N is being drawn.
+class RenderThread {
+public:
+    // Runs on the render thread; returns the renderer it will own, or nullptr on failure
+    using RendererFactory = std::function<SDL_Renderer*()>;
+
+    RenderThread() = default;
+    ~RenderThread();
+
+    // Start the thread and wait until the renderer exists. Returns false if it could not be created.
+    bool Start(RendererFactory create_renderer);
+
+    // Draw nothing further, release every texture and destroy the renderer
+    void Stop();
+
+    // Simulation side: list to fill for the next frame, then publish it
+    RenderCommandList& GetFrameCommands();
+    void Submit();
+
+    uint64_t GetPresentedFrames() const;
+
+    // Disallow copying and moving
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+private:
+    RenderCommandBuffer buffer;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending = false;     // A list was published since the thread last looked
+    bool stopping = false;
+    std::atomic<uint64_t> presented{0};
+
+    void Loop(RendererFactory create_renderer, std::promise<bool>& started);
+};
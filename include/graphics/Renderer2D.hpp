@@ -3,24 +3,85 @@
 #include <entt/entt.hpp>
 #include <SDL2/SDL.h>
 #include "Object2D.hpp"
+#include <SpriteBatch.hpp>
+#include <RenderCommandList.hpp>
 #include <ComponentManager.hpp>
 #include <RegistryManager.hpp>
+#include <atomic>
 #include <memory>
+#include <vector>
 #include <iostream>
 
 class Renderer2D {
 public:
     static Renderer2D& GetInstance();
 
+    // Call on the thread that will execute command lists
     void Initialize(SDL_Renderer* sdlRenderer);
+    void Shutdown();
 
-    void Render(float frame_duration);
+    // Simulation side: record the current frame into commands; alpha blends sprite
+    // positions between simulation steps. Never touches the SDL renderer.
+    void BuildCommands(RenderCommandList& commands, float frame_duration, float alpha = 1.0f);
+
+    // Rendering side: sync textures, clear and draw a published list (presenting is left to the caller)
+    void Execute(const RenderCommandList& commands);
+
+    // Build and execute on the calling thread
+    void Render(float frame_duration, float alpha = 1.0f);
 
     SDL_Renderer* GetSDLRenderer();
 
+    void SetClearColor(Uint8 r, Uint8 g, Uint8 b);
+
+    // Draw calls and sprites submitted during the last executed frame
+    int GetDrawCalls() const;
+    int GetSpriteCount() const;
+
+    // Sprites kept and skipped by viewport culling during the last rendered frame
+    int GetVisibleCount() const;
+    int GetCulledCount() const;
+
+    void SetCullingEnabled(bool enabled);
+    bool IsCullingEnabled() const;
+
+    // Draw a flat quad where a sprite's texture is still loading, instead of nothing
+    void SetPlaceholdersEnabled(bool enabled);
+
+    // Register the renderer stats in Lua
+    static void Register();
+
 private:
+    // Per-sprite work for the current frame, filled serially and culled in parallel
+    struct SpriteDraw {
+        SpriteComponent* sprite;
+        const Transform2D* transform;
+        Vector2 render_position;
+        bool visible;
+    };
+
+    static constexpr size_t cull_grain = 2048;
+
+    // Rendering thread
     SDL_Renderer* renderer = nullptr;
+    SpriteBatch sprite_batch;
+    SDL_Texture* placeholder_texture = nullptr; // 1x1, created on first use
+    std::atomic<int> draw_calls{0};
+    std::atomic<int> sprite_count{0};
+    std::atomic<int> viewport_width{0};  // Read by the simulation for centering and culling
+    std::atomic<int> viewport_height{0};
+
+    // Simulation thread
+    RenderCommandList immediate_commands; // Used by Render
+    SDL_Color clear_color = {164, 157, 157, 255};
     Vector2 last_camera_position = {0, 0};
+    bool culling_enabled = true;
+    bool placeholders_enabled = false;
+    int visible_count = 0;
+    int culled_count = 0;
+    std::vector<SpriteDraw> sprite_draws;
+
+    SDL_Texture* GetPlaceholderTexture();
 
     Renderer2D() = default;
     ~Renderer2D() = default;
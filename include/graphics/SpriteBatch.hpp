@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+
+// Collects sprite quads for a frame and draws each run of consecutive quads sharing a texture
+// with one SDL_RenderGeometry call instead of one copy per sprite, keeping submission order.
+class SpriteBatch {
+public:
+    // Start a new frame, keeping buffer capacity from previous frames
+    void Begin();
+
+    // Queue a quad sampling src from texture into dest
+    void Submit(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dest, bool flip_h, bool flip_v);
+
+    // Draw every queued quad in order and reset the batch buffers
+    void Flush(SDL_Renderer* renderer);
+
+    int GetDrawCalls() const;
+    int GetSpriteCount() const;
+
+private:
+    struct Batch {
+        SDL_Texture* texture = nullptr;
+        float inv_width = 0.0f;     // 1 / texture width, for normalized UVs
+        float inv_height = 0.0f;    // 1 / texture height
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    std::vector<Batch> batches;                          // Runs in draw order, reused between frames
+    size_t active_batches = 0;
+    int draw_calls = 0;
+    int sprite_count = 0;
+
+    Batch& GetBatch(SDL_Texture* texture);
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <LuaManager.hpp>
+#include <AtlasPacker.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <iostream>
+
+enum class TextureState : uint8_t {
+    Queued,     // Waiting for a decode thread
+    Decoding,
+    Decoded,    // width/height are valid; waiting for upload
+    Uploaded,   // SDL texture exists on the rendering thread
+    Failed
+};
+
+// Shared texture that many cached images draw from
+struct AtlasPage {
+    SDL_Texture* texture = nullptr;  // Created and read only on the rendering thread
+    SDL_Surface* surface = nullptr;  // Prebuilt atlas pixels waiting for upload
+    AtlasPacker packer;              // Free space on pages packed at runtime
+    int users = 0;                   // Entries placed on the page, plus one while a loaded atlas pins it
+};
+
+struct CachedTexture {
+    std::string path;
+    std::atomic<TextureState> state{TextureState::Queued};
+    SDL_Texture* texture = nullptr;   // Created and read only on the rendering thread
+    int width = 0;      // Cached so sprites never need SDL_QueryTexture; valid once decoded
+    int height = 0;
+    int ref_count = 0;
+    SDL_Surface* surface = nullptr;   // Decoded pixels waiting for upload
+    uint64_t release_generation = 0;  // Generation in which the last reference was dropped
+    AtlasPage* page = nullptr;        // Set when the image lives in an atlas instead of its own texture
+    int atlas_x = 0;                  // Offset of the image within the page
+    int atlas_y = 0;
+
+    // Rendering side: the texture to sample, with frames offset by atlas_x/atlas_y
+    SDL_Texture* GetTexture() const {
+        return page ? page->texture : texture;
+    }
+
+    // Simulation side: whether width/height can be read
+    bool IsDecoded() const {
+        TextureState current = state.load(std::memory_order_acquire);
+        return current == TextureState::Decoded || current == TextureState::Uploaded;
+    }
+};
+
+struct TextureCacheStats {
+    size_t loads = 0;      // Textures queued for decoding from disk
+    size_t hits = 0;       // Acquires served from the cache
+    size_t evictions = 0;  // Textures destroyed after their last release
+};
+
+// Decode queue and upload statistics, shared with the loader and rendering threads
+struct TextureLoadStats {
+    size_t queued = 0;           // Waiting for or being decoded
+    size_t pending_uploads = 0;  // Decoded but not yet uploaded
+    size_t decoded = 0;
+    size_t uploaded = 0;
+    size_t failures = 0;         // Decodes or uploads that failed
+    size_t atlas_pages = 0;      // Live atlas textures
+    size_t atlased = 0;          // Images packed into atlas pages at runtime
+    double decode_ms_total = 0.0;
+    double decode_ms_max = 0.0;
+    double upload_ms_last = 0.0; // Time spent uploading in the last Sync
+};
+
+// Reference-counted textures shared by path, so each image is decoded and uploaded once.
+// Acquire/Release run on the simulation thread and never block on disk: images are decoded by
+// loader threads, and SDL textures are only created (within a per-frame budget) and destroyed
+// by Sync on the thread that owns the renderer. Entries keep their address until destroyed,
+// so command lists can refer to them.
+class TextureCache {
+public:
+    static TextureCache& GetInstance();
+
+    // Get the entry for path, queueing it for decode on first use. Its size is known once
+    // IsDecoded(), and the SDL texture is created by a later Sync.
+    const CachedTexture* Acquire(const std::string& path);
+
+    // Drop one reference to path; the texture is destroyed once no command list can use it
+    void Release(const std::string& path);
+
+    // Start building a new command list; returns its generation
+    uint64_t AdvanceGeneration();
+
+    // Rendering thread: destroy textures released before generation, upload decoded ones within the budget
+    void Sync(SDL_Renderer* renderer, uint64_t generation);
+
+    // Destroy every texture regardless of references and stop the loader threads
+    // (call on the rendering thread, before the renderer goes away)
+    void Clear();
+
+    // Block until every queued image is decoded (benchmarks and tools)
+    void WaitForDecodes();
+
+    // Bytes of pixels uploaded per Sync; at least one texture is always uploaded
+    void SetUploadBudget(size_t bytes);
+
+    // Pack small images into shared pages as they are uploaded, so sprites batch together
+    void SetAtlasEnabled(bool enabled);
+
+    // Serve the images listed in an atlas built with --pack-atlas from its single texture.
+    // Decodes the atlas image on the calling thread; false if it can't be read.
+    bool LoadAtlas(const std::string& metadata_path);
+
+    size_t GetResidentCount() const;
+    const TextureCacheStats& GetStats() const;
+    TextureLoadStats GetLoadStats();
+
+    // Register the cache statistics in Lua
+    static void Register();
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<CachedTexture>> textures;
+    TextureCacheStats stats;
+    uint64_t generation = 0;
+
+    // Shared with the loader and rendering threads
+    std::mutex pending_mutex;
+    std::deque<CachedTexture*> uploads;
+    std::vector<std::unique_ptr<CachedTexture>> retired;
+    size_t upload_budget = 8 * 1024 * 1024;
+    TextureLoadStats load_stats;
+    bool atlas_enabled = true;
+    std::vector<std::unique_ptr<AtlasPage>> pages;
+
+    // Runtime atlas pages; larger images keep their own texture
+    static constexpr int atlas_page_size = 2048;
+    static constexpr int atlas_max_image_size = 512;
+    static constexpr int atlas_padding = 1;
+
+    // Images of loaded atlases, by path
+    struct AtlasRegion {
+        AtlasPage* page;
+        SDL_Rect rect;
+    };
+    std::unordered_map<std::string, AtlasRegion> atlas_regions;
+
+    // Loader threads
+    static constexpr int loader_count = 2;
+    std::vector<std::thread> loaders;
+    std::mutex decode_mutex;
+    std::condition_variable decode_wake;
+    std::condition_variable decode_idle;
+    std::deque<CachedTexture*> decode_queue;
+    size_t decoding = 0;
+    bool stopping_loaders = false;
+
+    TextureCache() = default;
+    ~TextureCache();
+
+    // Rendering thread, under pending_mutex
+    bool PlaceInAtlas(SDL_Renderer* renderer, CachedTexture& entry);
+    void ReleasePage(AtlasPage* page);
+
+    void StartLoaders();
+    void StopLoaders();
+    void LoaderLoop();
+
+    // Disallow copying and moving
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    TextureCache(TextureCache&&) = delete;
+    TextureCache& operator=(TextureCache&&) = delete;
+};
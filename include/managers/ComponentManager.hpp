@@ -7,6 +7,8 @@
 #include <InputComponent.hpp>
 #include <ScriptComponent.hpp>
 #include <SpriteComponent.hpp>
+#include <PhysicsComponent.hpp>
+#include <ColliderComponent.hpp>
 
 inline void RegisterComponents() {
     sol::state& lua = LuaManager::GetInstance();
@@ -18,5 +20,7 @@ inline void RegisterComponents() {
     InputComponent::Register();
     ScriptComponent::Register();
     CameraComponent::Register();
+    PhysicsComponent::Register();
+    ColliderComponent::Register();
 
 }
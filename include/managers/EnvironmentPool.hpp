@@ -0,0 +1,157 @@
+#pragma once
+
+#include <sol/sol.hpp>
+#include <LuaManager.hpp>
+#include <ObjectType.hpp>
+#include <deque>
+#include <vector>
+#include <iostream>
+
+// Lua state recycled together with an environment table. An owner's bindings are created
+// once per slot, in methods, and reach the owner through instance rather than capturing it,
+// so a reused slot needs no new tables or closures.
+struct EnvironmentSlot {
+    sol::table methods;         // Bound functions; lookups fall through to globals
+    sol::table callbacks;       // Object lifecycle callbacks; lookups fall through to methods
+    sol::table metatable;       // The environment's { __index = callbacks }, plus the owner's __newindex
+    sol::table released_meta;   // { __gc = return this slot to the free list }
+    sol::environment free_env;  // Held only while the slot is free
+    void* instance = nullptr;   // Owner while acquired, null once released
+    ObjectType type = ObjectType::Object;
+    bool needs_binding = true;  // New slot: the owner's constructors fill methods and metatable
+};
+
+// Recycles Lua environment tables for Objects and Components, one free list per type.
+// Released environments are emptied and only reused once Lua has dropped every
+// reference to them: a __gc finalizer resurrects the table into the free list.
+class EnvironmentPool {
+public:
+    // Get an empty environment for an owner of the given type; lookups fall through
+    // env -> callbacks -> methods -> globals
+    static EnvironmentSlot& Acquire(ObjectType type, sol::environment& env) {
+        State& state = GetState();
+        std::vector<EnvironmentSlot*>& free_slots = state.FreeSlots(type);
+        EnvironmentSlot* slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+            env = std::move(slot->free_env);
+            slot->needs_binding = false;
+            ++state.reused;
+        } else {
+            slot = &state.slots.emplace_back();
+            slot->type = type;
+            InitializeSlot(*slot);
+            env = sol::environment(LuaManager::GetInstance(), sol::create);
+            ++state.created;
+        }
+        env[sol::metatable_key] = slot->metatable;
+        return *slot;
+    }
+
+    // Empty env and the slot's callbacks, and hand the slot back once Lua no longer references env
+    static void Release(EnvironmentSlot& slot, sol::environment& env) {
+        if (!env.valid() || shutting_down) {
+            return;
+        }
+
+        ClearTable(env);
+        ClearTable(slot.callbacks);
+        slot.instance = nullptr;
+
+        // Setting a metatable with __gc marks the table for finalization
+        env[sol::metatable_key] = slot.released_meta;
+        env = sol::environment();
+        ++GetState().released;
+    }
+
+    static size_t GetCreatedCount() { return GetState().created; }
+    static size_t GetReusedCount() { return GetState().reused; }
+    static size_t GetFreeCount() {
+        size_t count = 0;
+        for (const auto& free_slots : GetState().free_slots) {
+            count += free_slots.size();
+        }
+        return count;
+    }
+
+    // Deleted constructors to prevent instantiation
+    EnvironmentPool() = delete;
+    ~EnvironmentPool() = delete;
+    EnvironmentPool(const EnvironmentPool&) = delete;
+    EnvironmentPool& operator=(const EnvironmentPool&) = delete;
+
+private:
+    struct State {
+        sol::table globals_meta;   // Shared { __index = _G }
+        std::deque<EnvironmentSlot> slots;  // Stable addresses: bindings point at their slot
+        std::vector<std::vector<EnvironmentSlot*>> free_slots; // Indexed by ObjectType
+        size_t created = 0;
+        size_t reused = 0;
+        size_t released = 0;
+
+        State() {
+            sol::state& lua = LuaManager::GetInstance();
+            globals_meta = lua.create_table();
+            globals_meta[sol::meta_function::index] = lua.globals();
+        }
+
+        ~State() {
+            shutting_down = true;
+        }
+
+        std::vector<EnvironmentSlot*>& FreeSlots(ObjectType type) {
+            const size_t index = static_cast<size_t>(type);
+            if (index >= free_slots.size()) {
+                free_slots.resize(index + 1);
+            }
+            return free_slots[index];
+        }
+    };
+
+    static inline bool shutting_down = false;
+
+    static State& GetState() {
+        static State state;
+        return state;
+    }
+
+    static void InitializeSlot(EnvironmentSlot& slot) {
+        sol::state& lua = LuaManager::GetInstance();
+        State& state = GetState();
+
+        slot.methods = lua.create_table();
+        slot.methods[sol::metatable_key] = state.globals_meta;
+
+        sol::table callbacks_meta = lua.create_table();
+        callbacks_meta[sol::meta_function::index] = slot.methods;
+        slot.callbacks = lua.create_table();
+        slot.callbacks[sol::metatable_key] = callbacks_meta;
+
+        slot.metatable = lua.create_table();
+        slot.metatable[sol::meta_function::index] = slot.callbacks;
+
+        EnvironmentSlot* recycled = &slot;
+        slot.released_meta = lua.create_table();
+        slot.released_meta[sol::meta_function::garbage_collect] = [recycled](sol::stack_reference env) {
+            // Finalizers also run from lua_close, after the pool is gone
+            if (!shutting_down) {
+                recycled->free_env = sol::environment(env);
+                GetState().FreeSlots(recycled->type).push_back(recycled);
+            }
+        };
+    }
+
+    static void ClearTable(const sol::table& table) {
+        lua_State* L = table.lua_state();
+        table.push();
+        lua_pushnil(L);
+        while (lua_next(L, -2) != 0) {
+            lua_pop(L, 1);              // Drop the value, keep the key
+            lua_pushvalue(L, -1);
+            lua_pushnil(L);
+            lua_rawset(L, -4);          // Clearing existing fields is safe during traversal
+        }
+        lua_pop(L, 1);
+    }
+};
@@ -15,6 +15,12 @@ local move_right = input.register_action("move_right", "Right", "pressed")
 
 local move_down = input.register_action("move_down", "Down", "pressed")
 
+-- Integer handles skip the name lookup on every input event
+local MOVE_UP = input.get_action_id("move_up")
+local MOVE_LEFT = input.get_action_id("move_left")
+local MOVE_RIGHT = input.get_action_id("move_right")
+local MOVE_DOWN = input.get_action_id("move_down")
+
 --MOVEMENT
 input_dir = Vector2.new(0, 0)
 velocity = Vector2.new(0, 0)
@@ -46,7 +52,7 @@ end
 
 
 function update_input_direction(event)
-    input_dir.x = input.get_action_strength("move_right") - input.get_action_strength("move_left")
-    input_dir.y = input.get_action_strength("move_down") - input.get_action_strength("move_up")
+    input_dir.x = input.get_action_strength(MOVE_RIGHT) - input.get_action_strength(MOVE_LEFT)
+    input_dir.y = input.get_action_strength(MOVE_DOWN) - input.get_action_strength(MOVE_UP)
     return input_dir
 end
\ No newline at end of file
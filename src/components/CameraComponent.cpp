@@ -1,14 +1,15 @@
 #include <CameraComponent.hpp>
+#include <Logger.hpp>
 
 // Constructor
 CameraComponent::CameraComponent(bool is_current)
-    : current(is_current), centered(true), smooth(0.0f), zoom(1.0f) {
+    : Component(ObjectType::CameraComponent), current(is_current), centered(true), smooth(0.0f), zoom(1.0f) {
     InitializeLuaBindings();
 }
 
 // Destructor
 CameraComponent::~CameraComponent() {
-    std::cout << "CameraComponent destroyed for entity ID: " << static_cast<int>(entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "CameraComponent destroyed for entity ID: ", static_cast<int>(entity));
 }
 
 // Emplace function
@@ -31,9 +32,9 @@ void CameraComponent::Register() {
     lua.new_usertype<CameraComponent>("CameraComponent",
         sol::constructors<CameraComponent(bool)>(),
         "new", sol::factories([](bool is_current) {
-            auto camera_instance = std::make_shared<CameraComponent>(is_current);
+            auto camera_instance = MakePooled<CameraComponent>(is_current);
             RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(camera_instance->entity, camera_instance);
-            RegistryManager::GetInstance().emplace<std::string>(camera_instance->entity, "CameraComponent");
+            RegistryManager::GetInstance().emplace<ObjectType>(camera_instance->entity, ObjectType::CameraComponent);
             return camera_instance->GetEnvironment();
         }),
         "entity", &CameraComponent::entity,
@@ -84,26 +85,34 @@ void CameraComponent::InitializeLuaBindings() {
     environment["centered"] = sol::as_table(std::ref(centered));
     environment["smooth"] = sol::as_table(std::ref(smooth));
     environment["zoom"] = sol::as_table(std::ref(zoom));
+    if (!environment_slot->needs_binding) {
+        return;
+    }
 
-    environment["set_current"] = [this]() {
-        SetCurrent(true);
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["set_current"] = [slot]() {
+        FromSlot<CameraComponent>(*slot).SetCurrent(true);
     };
 
-    environment["set_centered"] = [this](bool value) {
-        centered = value;
-        environment["centered"] = value;
+    methods["set_centered"] = [slot](bool value) {
+        CameraComponent& camera = FromSlot<CameraComponent>(*slot);
+        camera.centered = value;
+        camera.environment["centered"] = value;
     };
 
-    environment["set_smooth"] = [this](float value) {
-        smooth = value;
-        environment["smooth"] = value;
+    methods["set_smooth"] = [slot](float value) {
+        CameraComponent& camera = FromSlot<CameraComponent>(*slot);
+        camera.smooth = value;
+        camera.environment["smooth"] = value;
     };
 
-    environment["set_zoom"] = [this](float value) {
+    methods["set_zoom"] = [slot](float value) {
         if (value <= 0) {
             throw std::invalid_argument("Zoom must be greater than 0");
         }
-        zoom = value;
-        environment["zoom"] = value;
+        CameraComponent& camera = FromSlot<CameraComponent>(*slot);
+        camera.zoom = value;
+        camera.environment["zoom"] = value;
     };
 }
@@ -0,0 +1,109 @@
+#include <ColliderComponent.hpp>
+#include <Logger.hpp>
+#include <SpatialHash2D.hpp>
+
+// Constructor
+ColliderComponent::ColliderComponent(ColliderShape shape, const Vector2& size, const Vector2& offset, bool enabled)
+    : Component(ObjectType::ColliderComponent) {
+    initial_collider.shape = shape;
+    initial_collider.size = size;
+    initial_collider.offset = offset;
+    initial_collider.enabled = enabled;
+    InitializeLuaBindings();
+}
+
+// Destructor
+ColliderComponent::~ColliderComponent() {
+    Logger::Debug(LogCategory::Lifecycle, "ColliderComponent destroyed for entity ID: ", static_cast<int>(entity));
+}
+
+// Emplace function
+void ColliderComponent::Emplace(entt::entity owner) {
+    owner_entity = owner;
+    auto& registry = RegistryManager::GetInstance();
+    if (!registry.all_of<Transform2D>(owner)) {
+        Logger::Error(LogCategory::Lifecycle, "ColliderComponent requires an Object2D owner, entity ID: ", static_cast<int>(owner));
+        return;
+    }
+
+    auto self = std::dynamic_pointer_cast<ColliderComponent>(shared_from_this());
+    if (!self) {
+        throw std::runtime_error("Failed to cast to ColliderComponent");
+    }
+
+    registry.emplace<std::shared_ptr<ColliderComponent>>(owner, self);
+    collider = &registry.emplace_or_replace<Collider2D>(owner, initial_collider);
+    UpdateBounds();
+}
+
+Collider2D& ColliderComponent::GetCollider() {
+    return collider ? *collider : initial_collider;
+}
+
+void ColliderComponent::SetEnabled(bool enabled) {
+    GetCollider().enabled = enabled;
+}
+
+void ColliderComponent::SetSize(const Vector2& size) {
+    GetCollider().size = size;
+    UpdateBounds();
+}
+
+void ColliderComponent::SetOffset(const Vector2& offset) {
+    GetCollider().offset = offset;
+    UpdateBounds();
+}
+
+void ColliderComponent::UpdateBounds() {
+    if (!collider) {
+        return;
+    }
+    // Proxies are centered on the global position, so grow them to cover the offset
+    SpatialHash2D::GetInstance().SetExtents(owner_entity, collider->GetHalfExtents() + Vector2::Abs(collider->offset));
+}
+
+// Lua Registration
+void ColliderComponent::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    lua.new_enum("ColliderShape",
+        "Box", ColliderShape::Box,
+        "Circle", ColliderShape::Circle
+    );
+    lua.new_usertype<ColliderComponent>("ColliderComponent",
+        sol::constructors<ColliderComponent(ColliderShape, const Vector2&, const Vector2&, bool)>(),
+        "new", sol::factories([](ColliderShape shape, const Vector2& size, sol::optional<Vector2> offset, sol::optional<bool> enabled) {
+            auto collider_instance = MakePooled<ColliderComponent>(shape, size, offset.value_or(Vector2()), enabled.value_or(true));
+            RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(collider_instance->entity, collider_instance);
+            RegistryManager::GetInstance().emplace<ObjectType>(collider_instance->entity, ObjectType::ColliderComponent);
+            return collider_instance->GetEnvironment();
+        }),
+        "entity", &ColliderComponent::entity,
+        sol::base_classes, sol::bases<Component>()
+    );
+}
+
+// Initialize Lua Bindings
+void ColliderComponent::InitializeLuaBindings() {
+    if (!environment_slot->needs_binding) {
+        return;
+    }
+
+    // Extra arguments are ignored, so both collider.enable() and collider:enable() work
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["enable"] = [slot]() {
+        FromSlot<ColliderComponent>(*slot).SetEnabled(true);
+    };
+    methods["disable"] = [slot]() {
+        FromSlot<ColliderComponent>(*slot).SetEnabled(false);
+    };
+    methods["is_enabled"] = [slot]() {
+        return FromSlot<ColliderComponent>(*slot).GetCollider().enabled;
+    };
+    methods["set_size"] = [slot](float x, float y) {
+        FromSlot<ColliderComponent>(*slot).SetSize(Vector2(x, y));
+    };
+    methods["set_offset"] = [slot](float x, float y) {
+        FromSlot<ColliderComponent>(*slot).SetOffset(Vector2(x, y));
+    };
+}
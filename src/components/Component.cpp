@@ -1,20 +1,23 @@
 #include <Component.hpp>
+#include <Logger.hpp>
 
 
 // Constructor
-Component::Component() : entity(RegistryManager::GetInstance().create()) {
-    std::cout << "Component created with entity ID: " << static_cast<int>(entity) << "\n";
+Component::Component() : Component(ObjectType::Component) {}
 
-    // Create Lua environment and bind the component
-    sol::state& lua = LuaManager::GetInstance();
-    environment = sol::environment(lua, sol::create, lua.globals());
-    environment["instance"] = this;
-    environment["entity"] = entity;
+Component::Component(ObjectType type) : entity(RegistryManager::GetInstance().create()) {
+    Logger::Debug(LogCategory::Lifecycle, "Component created with entity ID: ", static_cast<int>(entity));
+
+    // Take a pooled Lua environment and bind the component
+    environment_slot = &EnvironmentPool::Acquire(type, environment);
+    environment_slot->instance = this;
+    environment.raw_set("instance", static_cast<void*>(this), "entity", entity);
 }
 
 // Destructor
 Component::~Component() {
-    std::cout << "Component destroyed for entity ID: " << static_cast<int>(entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "Component destroyed for entity ID: ", static_cast<int>(entity));
+    EnvironmentPool::Release(*environment_slot, environment);
 }
 
 // Register the Component class in Lua
@@ -23,9 +26,9 @@ void Component::Register() {
     lua.new_usertype<Component>("Component",
         sol::constructors<Component()>(),
         "new", sol::factories([]() {
-            auto comp_instance = std::make_shared<Component>();
+            auto comp_instance = MakePooled<Component>();
             RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(comp_instance->entity, comp_instance);
-            RegistryManager::GetInstance().emplace<std::string>(comp_instance->entity, "Component");
+            RegistryManager::GetInstance().emplace<ObjectType>(comp_instance->entity, ObjectType::Component);
             return comp_instance->GetEnvironment();
         }),
         "entity", &Component::entity
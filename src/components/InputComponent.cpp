@@ -1,24 +1,59 @@
 #include <InputComponent.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+
+std::bitset<SDL_NUM_SCANCODES> InputComponent::keyboard_state;
+uint64_t InputComponent::bindings_version = 0;
+
+namespace {
+
+// Key names from scripts resolve to the same keycode every time
+SDL_Keycode GetKeyFromNameCached(const std::string& key_name) {
+    static std::unordered_map<std::string, SDL_Keycode> keys;
+    auto it = keys.find(key_name);
+    if (it == keys.end()) {
+        it = keys.emplace(key_name, SDL_GetKeyFromName(key_name.c_str())).first;
+    }
+    return it->second;
+}
+
+uint32_t EventTypeFromState(const std::string& state) {
+    return state == "pressed" ? SDL_KEYDOWN : state == "released" ? SDL_KEYUP : 0;
+}
+
+} // namespace
 
 // Constructor
-InputComponent::InputComponent() : Component() {
+InputComponent::InputComponent() : Component(ObjectType::InputComponent) {
     InitializeLuaBindings();
 }
 
 // Destructor
 InputComponent::~InputComponent() {
-    std::cout << "InputComponent destroyed for entity ID: " << static_cast<int>(entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "InputComponent destroyed for entity ID: ", static_cast<int>(entity));
+    ++bindings_version;
 }
 
 // Register key bindings for actions
 sol::environment InputComponent::RegisterAction(const std::string& action, const std::string& key_name, const std::string& event_type) {
-    int key_sym = SDL_GetKeyFromName(key_name.c_str());
-    uint32_t sdl_event_type = (event_type == "pressed") ? SDL_KEYDOWN :
-                              (event_type == "released") ? SDL_KEYUP : 0;
+    int key_sym = GetKeyFromNameCached(key_name);
+    uint32_t sdl_event_type = EventTypeFromState(event_type);
     sol::state& lua = LuaManager::GetInstance();
     if (key_sym != 0 && sdl_event_type != 0) {
-        // Add to key_bindings for internal C++ logic
-        key_bindings[key_sym][sdl_event_type] = action;
+        // Compile the binding: action id -> scancodes, resolved once here rather than per query
+        auto [id_it, inserted] = action_ids.try_emplace(action, static_cast<int>(actions.size()));
+        if (inserted) {
+            actions.push_back({action, {}, {}});
+        }
+        std::vector<SDL_Scancode>& scancodes = actions[id_it->second].scancodes;
+        SDL_Scancode scancode = SDL_GetScancodeFromKey(key_sym);
+        if (scancode != SDL_SCANCODE_UNKNOWN) {
+            if (std::find(scancodes.begin(), scancodes.end(), scancode) == scancodes.end()) {
+                scancodes.push_back(scancode);
+            }
+            actions[id_it->second].triggers.push_back({scancode, sdl_event_type});
+            ++bindings_version;
+        }
 
         // Ensure lua_env["actions"] exists
         if (!environment["actions"].valid() || environment["actions"].get_type() != sol::type::table) {
@@ -41,21 +76,55 @@ sol::environment InputComponent::RegisterAction(const std::string& action, const
     return environment["actions"][action];
 }
 
+int InputComponent::GetActionId(const std::string& action) const {
+    auto it = action_ids.find(action);
+    return it != action_ids.end() ? it->second : -1;
+}
+
 // Check action state
-float InputComponent::GetActionStrength(const std::string& action) {
-    for (const auto& [key, event_map] : key_bindings) {
-        for (const auto& [event_type, mapped_action] : event_map) {
-            if (mapped_action == action) {
-                const Uint8* keyboard_state = SDL_GetKeyboardState(nullptr);
-                if (keyboard_state[SDL_GetScancodeFromKey(key)]) {
-                    return 1.0f; // Fully pressed
-                }
-            }
+float InputComponent::GetActionStrength(int action_id) const {
+    if (action_id < 0 || action_id >= static_cast<int>(actions.size())) {
+        return 0.0f;
+    }
+    for (SDL_Scancode scancode : actions[action_id].scancodes) {
+        if (keyboard_state[scancode]) {
+            return 1.0f; // Fully pressed
         }
     }
     return 0.0f; // Not pressed
 }
 
+float InputComponent::GetActionStrength(const std::string& action) const {
+    return GetActionStrength(GetActionId(action));
+}
+
+void InputComponent::SnapshotKeyboard() {
+    int count = 0;
+    const Uint8* state = SDL_GetKeyboardState(&count);
+    keyboard_state.reset();
+    for (int i = 0; i < count && i < SDL_NUM_SCANCODES; ++i) {
+        if (state[i]) {
+            keyboard_state.set(i);
+        }
+    }
+}
+
+bool InputComponent::IsScancodeDown(SDL_Scancode scancode) {
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && keyboard_state[scancode];
+}
+
+const std::bitset<SDL_NUM_SCANCODES>& InputComponent::GetKeyboardState() {
+    return keyboard_state;
+}
+
+void InputComponent::SetKeyboardState(const std::bitset<SDL_NUM_SCANCODES>& state) {
+    keyboard_state = state;
+}
+
+uint64_t InputComponent::GetBindingsVersion() {
+    return bindings_version;
+}
+
 // Check if an action is triggered by an event
 bool InputComponent::IsActionTriggered(const sol::table& event_table, const sol::table& action_table) {
     // Retrieve the key symbol and event state from the event table
@@ -71,7 +140,7 @@ bool InputComponent::IsActionTriggered(const sol::table& event_table, const sol:
         if (action_key_name.get_type() == sol::type::string) {
             std::string key_name = action_key_name.as<std::string>();
 
-            int action_key_sym = SDL_GetKeyFromName(key_name.c_str());
+            int action_key_sym = GetKeyFromNameCached(key_name);
 
             if (action_key_sym == event_key_sym) {
                 // Check if the state matches
@@ -87,15 +156,31 @@ bool InputComponent::IsActionTriggered(const sol::table& event_table, const sol:
     return false;
 }
 
+bool InputComponent::IsActionTriggered(const sol::table& event_table, int action_id) const {
+    int event_key_sym = event_table["key_sym"].get_or(-1);
+    uint32_t event_type = EventTypeFromState(event_table["state"].get_or(std::string("")));
+    if (event_key_sym == -1 || event_type == 0 || action_id < 0 || action_id >= static_cast<int>(actions.size())) {
+        return false;
+    }
+
+    SDL_Scancode scancode = SDL_GetScancodeFromKey(event_key_sym);
+    for (const ActionTrigger& trigger : actions[action_id].triggers) {
+        if (trigger.scancode == scancode && trigger.event_type == event_type) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Bind Lua functionality
 void InputComponent::Register() {
     sol::state& lua = LuaManager::GetInstance();
     lua.new_usertype<InputComponent>("InputComponent",
         sol::constructors<InputComponent()>(),
         "new", sol::factories([]() {
-            auto input_instance = std::make_shared<InputComponent>();
+            auto input_instance = MakePooled<InputComponent>();
             RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(input_instance->entity, input_instance);
-            RegistryManager::GetInstance().emplace<std::string>(input_instance->entity, "InputComponent");
+            RegistryManager::GetInstance().emplace<ObjectType>(input_instance->entity, ObjectType::InputComponent);
             return input_instance->GetEnvironment();
         }),
         "entity", &InputComponent::entity,
@@ -107,6 +192,8 @@ void InputComponent::Register() {
 void InputComponent::Emplace(entt::entity owner) {
     owner_entity = owner;
 
+    ++bindings_version;
+
     // Explicitly cast the base pointer to the derived type
     auto self = std::dynamic_pointer_cast<InputComponent>(shared_from_this());
     if (!self) {
@@ -119,15 +206,34 @@ void InputComponent::Emplace(entt::entity owner) {
 
 // Initialize Lua bindings
 void InputComponent::InitializeLuaBindings() {
-    environment["register_action"] = [this](const std::string& action, const std::string& key_name, const std::string& event_type) {
-        return RegisterAction(action, key_name, event_type);
-    };
+    if (!environment_slot->needs_binding) {
+        return;
+    }
 
-    environment["get_action_strength"] = [this](const std::string& action) -> float {
-        return GetActionStrength(action);
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["register_action"] = [slot](const std::string& action, const std::string& key_name, const std::string& event_type) {
+        return FromSlot<InputComponent>(*slot).RegisterAction(action, key_name, event_type);
     };
 
-    environment["is_action_triggered"] = [this](const sol::table& event_table, const sol::table& action_table) -> bool {
-        return IsActionTriggered(event_table, action_table);
+    // Integer handle for get_action_strength, so per-event checks skip the name lookup
+    methods["get_action_id"] = [slot](const std::string& action) -> int {
+        return FromSlot<InputComponent>(*slot).GetActionId(action);
     };
+
+    methods["get_action_strength"] = sol::overload(
+        [slot](int action_id) -> float {
+            return FromSlot<InputComponent>(*slot).GetActionStrength(action_id);
+        },
+        [slot](const std::string& action) -> float {
+            return FromSlot<InputComponent>(*slot).GetActionStrength(action);
+        });
+
+    methods["is_action_triggered"] = sol::overload(
+        [slot](const sol::table& event_table, int action_id) -> bool {
+            return FromSlot<InputComponent>(*slot).IsActionTriggered(event_table, action_id);
+        },
+        [slot](const sol::table& event_table, const sol::table& action_table) -> bool {
+            return FromSlot<InputComponent>(*slot).IsActionTriggered(event_table, action_table);
+        });
 }
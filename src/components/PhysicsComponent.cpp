@@ -0,0 +1,92 @@
+#include <PhysicsComponent.hpp>
+#include <Logger.hpp>
+
+// Constructor
+PhysicsComponent::PhysicsComponent(float mass, bool use_gravity) : Component(ObjectType::PhysicsComponent) {
+    initial_body.mass = mass;
+    initial_body.use_gravity = use_gravity;
+    InitializeLuaBindings();
+}
+
+// Destructor
+PhysicsComponent::~PhysicsComponent() {
+    Logger::Debug(LogCategory::Lifecycle, "PhysicsComponent destroyed for entity ID: ", static_cast<int>(entity));
+}
+
+// Emplace function
+void PhysicsComponent::Emplace(entt::entity owner) {
+    owner_entity = owner;
+    auto& registry = RegistryManager::GetInstance();
+    if (!registry.all_of<Transform2D>(owner)) {
+        Logger::Error(LogCategory::Lifecycle, "PhysicsComponent requires an Object2D owner, entity ID: ", static_cast<int>(owner));
+        return;
+    }
+
+    auto self = std::dynamic_pointer_cast<PhysicsComponent>(shared_from_this());
+    if (!self) {
+        throw std::runtime_error("Failed to cast to PhysicsComponent");
+    }
+
+    registry.emplace<std::shared_ptr<PhysicsComponent>>(owner, self);
+    body = &registry.emplace_or_replace<RigidBody2D>(owner, initial_body);
+}
+
+RigidBody2D& PhysicsComponent::GetBody() {
+    return body ? *body : initial_body;
+}
+
+// Lua Registration
+void PhysicsComponent::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    lua.new_usertype<PhysicsComponent>("PhysicsComponent",
+        sol::constructors<PhysicsComponent(float, bool)>(),
+        "new", sol::factories([](sol::optional<float> mass, sol::optional<bool> use_gravity) {
+            auto physics_instance = MakePooled<PhysicsComponent>(mass.value_or(1.0f), use_gravity.value_or(true));
+            RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(physics_instance->entity, physics_instance);
+            RegistryManager::GetInstance().emplace<ObjectType>(physics_instance->entity, ObjectType::PhysicsComponent);
+            return physics_instance->GetEnvironment();
+        }),
+        "entity", &PhysicsComponent::entity,
+        sol::base_classes, sol::bases<Component>()
+    );
+}
+
+// Initialize Lua Bindings
+void PhysicsComponent::InitializeLuaBindings() {
+    if (!environment_slot->needs_binding) {
+        return;
+    }
+
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["set_velocity"] = [slot](float x, float y) {
+        FromSlot<PhysicsComponent>(*slot).GetBody().velocity = Vector2(x, y);
+    };
+    methods["get_velocity"] = [slot]() {
+        return FromSlot<PhysicsComponent>(*slot).GetBody().velocity;
+    };
+    methods["apply_impulse"] = [slot](float x, float y) {
+        RigidBody2D& rigid_body = FromSlot<PhysicsComponent>(*slot).GetBody();
+        if (rigid_body.mass > 0.0f) {
+            rigid_body.velocity = rigid_body.velocity + Vector2(x, y) / rigid_body.mass;
+        }
+    };
+    methods["set_mass"] = [slot](float mass) {
+        FromSlot<PhysicsComponent>(*slot).GetBody().mass = mass;
+    };
+    methods["set_gravity_scale"] = [slot](float scale) {
+        FromSlot<PhysicsComponent>(*slot).GetBody().gravity_scale = scale;
+    };
+    methods["set_drag"] = [slot](float drag) {
+        FromSlot<PhysicsComponent>(*slot).GetBody().drag = drag;
+    };
+    methods["set_use_gravity"] = [slot](bool use_gravity) {
+        FromSlot<PhysicsComponent>(*slot).GetBody().use_gravity = use_gravity;
+    };
+    methods["is_colliding"] = [slot]() {
+        return FromSlot<PhysicsComponent>(*slot).GetBody().colliding;
+    };
+    methods["get_collision_normal"] = [slot]() {
+        return FromSlot<PhysicsComponent>(*slot).GetBody().collision_normal;
+    };
+}
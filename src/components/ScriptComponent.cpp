@@ -1,7 +1,10 @@
 #include <ScriptComponent.hpp>
+#include <Logger.hpp>
+#include <ScriptCache.hpp>
+#include <LuaProfiler.hpp>
 
 ScriptComponent::ScriptComponent()
-    : Component() {
+    : Component(ObjectType::ScriptComponent) {
     InitializeLuaBindings();
 }
 
@@ -9,12 +12,13 @@ sol::environment ScriptComponent::AddScript(const std::string& scriptPath) {
     try {
         sol::state& lua = LuaManager::GetInstance();
         sol::environment scriptEnv(lua, sol::create, lua.globals());
-        lua.script_file(scriptPath, scriptEnv);
+        LuaProfiler::Scope profile_scope(owner_entity);
+        ScriptCache::GetInstance().Run(scriptPath, scriptEnv);
         scripts[scriptPath] = scriptEnv;
-        std::cout << "Loaded script: " << scriptPath << "\n";
+        Logger::Info(LogCategory::Script, "Loaded script: ", scriptPath);
         return scriptEnv; // Return the environment of the added script
     } catch (const sol::error& e) {
-        std::cerr << "Error loading script: " << e.what() << "\n";
+        Logger::Error(LogCategory::Script, "Error loading script: ", e.what());
         throw; // Rethrow to notify Lua of the error
     }
 }
@@ -23,9 +27,9 @@ void ScriptComponent::RemoveScript(const std::string& scriptPath) {
     auto it = scripts.find(scriptPath);
     if (it != scripts.end()) {
         scripts.erase(it);
-        std::cout << "Removed script: " << scriptPath << "\n";
+        Logger::Info(LogCategory::Script, "Removed script: ", scriptPath);
     } else {
-        std::cerr << "Script not found: " << scriptPath << "\n";
+        Logger::Error(LogCategory::Script, "Script not found: ", scriptPath);
     }
 }
 
@@ -38,6 +42,15 @@ sol::environment ScriptComponent::GetScriptEnvironment(const std::string& script
     }
 }
 
+void ScriptComponent::ReloadScript(const std::string& scriptPath) {
+    auto it = scripts.find(scriptPath);
+    if (it == scripts.end()) {
+        throw std::runtime_error("Script not found: " + scriptPath);
+    }
+    LuaProfiler::Scope profile_scope(owner_entity);
+    ScriptCache::GetInstance().Reload(scriptPath, it->second);
+}
+
 std::vector<std::string> ScriptComponent::ListScripts() const {
     std::vector<std::string> scriptPaths;
     for (const auto& [path, _] : scripts) {
@@ -64,9 +77,9 @@ void ScriptComponent::Register() {
     lua.new_usertype<ScriptComponent>("ScriptComponent",
         sol::constructors<ScriptComponent()>(),
         "new", sol::factories([]() {
-            auto script_instance = std::make_shared<ScriptComponent>();
+            auto script_instance = MakePooled<ScriptComponent>();
             RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(script_instance->entity, script_instance);
-            RegistryManager::GetInstance().emplace<std::string>(script_instance->entity, "ScriptComponent");
+            RegistryManager::GetInstance().emplace<ObjectType>(script_instance->entity, ObjectType::ScriptComponent);
             return script_instance->GetEnvironment();
         }),
         "entity", &ScriptComponent::entity,
@@ -79,20 +92,26 @@ void ScriptComponent::Register() {
 }
 
 ScriptComponent::~ScriptComponent() {
-    std::cout << "ScriptComponent destroyed for entity ID: " << static_cast<int>(entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "ScriptComponent destroyed for entity ID: ", static_cast<int>(entity));
 }
 
 void ScriptComponent::InitializeLuaBindings() {
-    environment["add_script"] = [this](const std::string& scriptPath) {
-        return AddScript(scriptPath);
+    if (!environment_slot->needs_binding) {
+        return;
+    }
+
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["add_script"] = [slot](const std::string& scriptPath) {
+        return FromSlot<ScriptComponent>(*slot).AddScript(scriptPath);
     };
-    environment["remove_script"] = [this](const std::string& scriptPath) {
-        RemoveScript(scriptPath);
+    methods["remove_script"] = [slot](const std::string& scriptPath) {
+        FromSlot<ScriptComponent>(*slot).RemoveScript(scriptPath);
     };
-    environment["get_script"] = [this](const std::string& scriptPath) {
-        return GetScriptEnvironment(scriptPath);
+    methods["get_script"] = [slot](const std::string& scriptPath) {
+        return FromSlot<ScriptComponent>(*slot).GetScriptEnvironment(scriptPath);
     };
-    environment["list_scripts"] = [this]() -> std::vector<std::string> {
-        return ListScripts();
+    methods["list_scripts"] = [slot]() -> std::vector<std::string> {
+        return FromSlot<ScriptComponent>(*slot).ListScripts();
     };
 }
@@ -1,46 +1,63 @@
 #include <SpriteComponent.hpp>
+#include <Logger.hpp>
+#include <Profiler.hpp>
 
 SpriteComponent::SpriteComponent(const std::string& path)
-    : texturePath(path), texture(nullptr) {
+    : Component(ObjectType::SpriteComponent), texturePath(path), texture(nullptr) {
     InitializeLuaBindings();
 }
 
 SpriteComponent::~SpriteComponent() {
-    if (texture) {
-        SDL_DestroyTexture(texture);
+    ReleaseTexture();
+    Logger::Debug(LogCategory::Lifecycle, "SpriteComponent destroyed for entity ID: ", static_cast<int>(entity));
+}
+
+void SpriteComponent::LoadTexture(const std::string& path) {
+    ProfileZone zone("SpriteComponent::LoadTexture");
+    if (texture && currentTexturePath == path) {
+        return; // Already holding this texture
+    }
+
+    texturePath = path;
+    ReleaseTexture();
+
+    if (texturePath.empty()) {
+        Logger::Error(LogCategory::Assets, "Texture path is empty. Cannot load texture.");
+        return;
     }
-    std::cout << "SpriteComponent destroyed for entity ID: " << static_cast<int>(entity) << "\n";
+
+    const CachedTexture* cached = TextureCache::GetInstance().Acquire(texturePath);
+    if (!cached) {
+        return;
+    }
+
+    // Decoding happens in the background; the size is picked up once it's known
+    texture = cached;
+    currentTexturePath = texturePath;
+    RefreshTextureSize();
+    Logger::Debug(LogCategory::Assets, "Texture requested from: ", texturePath);
 }
 
-void SpriteComponent::LoadTexture(const std::string& path, SDL_Renderer* renderer) {
-    if (texturePath != path || !texture) { // Check if the texturePath has changed
-        texturePath = path;
-
-        if (texture) {
-            SDL_DestroyTexture(texture);
-            texture = nullptr;
-        }
-
-        if (texturePath.empty()) {
-            std::cerr << "Texture path is empty. Cannot load texture.\n";
-            return;
-        }
-
-        SDL_Surface* surface = IMG_Load(texturePath.c_str());
-        if (!surface) {
-            std::cerr << "Failed to load texture: " << IMG_GetError() << "\n";
-            return;
-        }
-
-        texture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!texture) {
-            std::cerr << "Failed to create texture: " << SDL_GetError() << "\n";
-            return;
-        }
-
-        UpdateFrameCoords();
-        std::cout << "Texture loaded successfully from: " << texturePath << "\n";
+bool SpriteComponent::RefreshTextureSize() {
+    if (texture_width > 0) {
+        return true;
+    }
+    if (!texture || !texture->IsDecoded()) {
+        return false;
+    }
+    texture_width = texture->width;
+    texture_height = texture->height;
+    UpdateFrameCoords();
+    return true;
+}
+
+void SpriteComponent::ReleaseTexture() {
+    if (texture) {
+        TextureCache::GetInstance().Release(currentTexturePath);
+        texture = nullptr;
+        texture_width = 0;
+        texture_height = 0;
+        currentTexturePath.clear();
     }
 }
 
@@ -50,10 +67,7 @@ void SpriteComponent::SetFrame(int f) {
 }
 
 void SpriteComponent::UpdateFrameCoords() {
-    if (!texture) return;
-
-    int texture_width, texture_height;
-    SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
+    if (!texture || texture_width == 0) return;
 
     int frame_width = texture_width / hframes;
     int frame_height = texture_height / vframes;
@@ -64,41 +78,39 @@ void SpriteComponent::UpdateFrameCoords() {
     frame_coords.h = frame_height;
 }
 
-void SpriteComponent::Render(SDL_Renderer* renderer, int x, int y) {
+bool SpriteComponent::HasCurrentTexture() const {
+    return texture && currentTexturePath == texturePath && texture_width > 0;
+}
+
+void SpriteComponent::Render(RenderCommandList& commands, int x, int y) {
     if (texturePath.empty()) {
-        std::cerr << "No texture path set. Cannot render.\n";
+        Logger::Error(LogCategory::Assets, "No texture path set. Cannot render.");
         return;
     }
 
-    if (!texture) {
-        LoadTexture(texturePath, renderer);
+    if (!HasCurrentTexture()) {
+        LoadTexture(texturePath);
     }
 
-    if (!texture) {
-        std::cerr << "Failed to load texture for rendering.\n";
+    if (!texture || texture->state.load(std::memory_order_acquire) == TextureState::Failed) {
         return;
     }
 
-    if (currentTexturePath != texturePath) {
-        LoadTexture(texturePath, renderer);
-        currentTexturePath = texturePath;
+    // Until the image is decoded the renderer may draw a placeholder of a default size
+    SDL_Rect frame = frame_coords;
+    if (!RefreshTextureSize()) {
+        frame = {0, 0, placeholder_size, placeholder_size};
     }
 
     // Center the sprite on the given position
-    SDL_Rect dest_rect = {
-        x - frame_coords.w / 2, // Adjust x to center horizontally
-        y - frame_coords.h / 2, // Adjust y to center vertically
-        frame_coords.w,
-        frame_coords.h
+    SDL_FRect dest_rect = {
+        static_cast<float>(x - frame.w / 2), // Adjust x to center horizontally
+        static_cast<float>(y - frame.h / 2), // Adjust y to center vertically
+        static_cast<float>(frame.w),
+        static_cast<float>(frame.h)
     };
 
-    SDL_RendererFlip flip = SDL_FLIP_NONE;
-    if (flipped_h) flip = (SDL_RendererFlip)(flip | SDL_FLIP_HORIZONTAL);
-    if (flipped_v) flip = (SDL_RendererFlip)(flip | SDL_FLIP_VERTICAL);
-
-    if (SDL_RenderCopyEx(renderer, texture, &frame_coords, &dest_rect, 0, nullptr, flip) != 0) {
-        std::cerr << "Failed to render texture: " << SDL_GetError() << "\n";
-    }
+    commands.sprites.push_back({texture, frame, dest_rect, flipped_h, flipped_v});
 }
 
 void SpriteComponent::Emplace(entt::entity owner) {
@@ -123,9 +135,9 @@ void SpriteComponent::Register() {
     lua.new_usertype<SpriteComponent>("SpriteComponent",
         sol::constructors<SpriteComponent(const std::string&)>(),
         "new", sol::factories([](const std::string& path) {
-            auto sprite_instance = std::make_shared<SpriteComponent>(path);
+            auto sprite_instance = MakePooled<SpriteComponent>(path);
             RegistryManager::GetInstance().emplace<std::shared_ptr<Component>>(sprite_instance->entity, sprite_instance);
-            RegistryManager::GetInstance().emplace<std::string>(sprite_instance->entity, "SpriteComponent");
+            RegistryManager::GetInstance().emplace<ObjectType>(sprite_instance->entity, ObjectType::SpriteComponent);
             return sprite_instance->GetEnvironment();
         }),
         "entity", &SpriteComponent::entity,
@@ -140,7 +152,12 @@ void SpriteComponent::InitializeLuaBindings() {
     environment["frame"] = std::ref(frame);
     environment["flipped_h"] = std::ref(flipped_h);
     environment["flipped_v"] = std::ref(flipped_v);
-    environment["set_texture"] = [this](const std::string& path) {
-        SetTexturePath(path);
+    if (!environment_slot->needs_binding) {
+        return;
+    }
+
+    EnvironmentSlot* slot = environment_slot;
+    slot->methods["set_texture"] = [slot](const std::string& path) {
+        FromSlot<SpriteComponent>(*slot).SetTexturePath(path);
     };
 }
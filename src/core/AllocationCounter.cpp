@@ -0,0 +1,124 @@
+#include <AllocationCounter.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> heap_allocations{0};
+std::atomic<uint64_t> lua_allocations{0};
+
+// Allocator replaced by InstallLuaCounter
+lua_Alloc wrapped_alloc = nullptr;
+void* wrapped_data = nullptr;
+
+void* CountingLuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    // With ptr == nullptr, osize holds the object type rather than a size
+    if (nsize > 0 && (ptr == nullptr || nsize > osize)) {
+        lua_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return wrapped_alloc(ud, ptr, osize, nsize);
+}
+
+} // namespace
+
+#ifdef ROGUE_COUNT_ALLOCATIONS
+
+namespace {
+
+void* CountedAlloc(std::size_t size) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            return nullptr;
+        }
+        try {
+            handler();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+} // namespace
+
+// Aligned new keeps the default implementation and is not counted
+void* operator new(std::size_t size) {
+    if (void* ptr = CountedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = CountedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif
+
+uint64_t AllocationCounter::GetHeapAllocations() {
+    return heap_allocations.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::InstallLuaCounter(lua_State* L) {
+    if (wrapped_alloc) {
+        return;
+    }
+    wrapped_alloc = lua_getallocf(L, &wrapped_data);
+    lua_setallocf(L, &CountingLuaAlloc, wrapped_data);
+}
+
+void AllocationCounter::UninstallLuaCounter(lua_State* L) {
+    if (!wrapped_alloc) {
+        return;
+    }
+    lua_setallocf(L, wrapped_alloc, wrapped_data);
+    wrapped_alloc = nullptr;
+    wrapped_data = nullptr;
+}
+
+uint64_t AllocationCounter::GetLuaAllocations() {
+    return lua_allocations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,421 @@
+#include <AssetArchive.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct AssetArchive::MappedFile {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    bool Open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) return false;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(file_size.QuadPart);
+        return data != nullptr;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping keeps the file alive
+        if (mapped == MAP_FAILED) return false;
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+};
+
+namespace {
+
+constexpr size_t header_size = 32;
+constexpr size_t index_entry_size = 32; // Fixed part, followed by the path
+constexpr uint64_t max_entry_size = INT_MAX;  // SDL_RWFromConstMem takes an int size
+constexpr uint64_t max_lz4_ratio = 255;       // An LZ4 byte expands to at most 255 bytes
+
+std::string NormalizePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+uint32_t Read32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t Read64(const uint8_t* p) {
+    return static_cast<uint64_t>(Read32(p)) | static_cast<uint64_t>(Read32(p + 4)) << 32;
+}
+
+void Write32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void Write64(std::vector<uint8_t>& out, uint64_t value) {
+    Write32(out, static_cast<uint32_t>(value));
+    Write32(out, static_cast<uint32_t>(value >> 32));
+}
+
+// LZ4 block format: sequences of [token][literal length+][literals][offset][match length+]
+void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    for (; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length) {
+    const size_t match_code = match_length >= 4 ? match_length - 4 : 0;
+    out.push_back(static_cast<uint8_t>((std::min<size_t>(literal_length, 15) << 4) |
+                                       (match_length ? std::min<size_t>(match_code, 15) : 0)));
+    if (literal_length >= 15) WriteLength(out, literal_length - 15);
+    out.insert(out.end(), literals, literals + literal_length);
+    if (match_length == 0) {
+        return; // Final literals-only sequence
+    }
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_code >= 15) WriteLength(out, match_code - 15);
+}
+
+// Greedy single-probe compressor; favours simplicity over ratio
+void Lz4Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+    constexpr size_t min_match = 4;
+    constexpr size_t last_literals = 5;   // The block always ends in at least 5 literals
+    constexpr size_t match_start_limit = 12;
+    constexpr uint32_t none = UINT32_MAX;
+
+    out.clear();
+    std::vector<uint32_t> table(1 << 16, none);
+    size_t anchor = 0;
+    size_t i = 0;
+    const size_t limit = size > match_start_limit ? size - match_start_limit : 0;
+    while (i < limit) {
+        const uint32_t sequence = Read32(src + i);
+        const uint32_t hash = (sequence * 2654435761u) >> 16;
+        const uint32_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i);
+        if (candidate == none || i - candidate > 65535 || Read32(src + candidate) != sequence) {
+            ++i;
+            continue;
+        }
+        size_t length = min_match;
+        while (i + length < size - last_literals && src[candidate + length] == src[i + length]) {
+            ++length;
+        }
+        EmitSequence(out, src + anchor, i - anchor, i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+    EmitSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool Lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    const uint8_t* ip = src;
+    const uint8_t* const ip_end = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* const op_end = dst + dst_size;
+
+    auto read_length = [&](size_t& length) {
+        uint8_t byte;
+        do {
+            if (ip >= ip_end) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < ip_end) {
+        const uint8_t token = *ip++;
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(literal_length)) return false;
+        if (static_cast<size_t>(ip_end - ip) < literal_length || static_cast<size_t>(op_end - op) < literal_length) return false;
+        std::memcpy(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        if (ip == ip_end) break; // Last sequence has no match
+
+        if (ip_end - ip < 2) return false;
+        const size_t offset = ip[0] | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(match_length)) return false;
+        match_length += 4;
+        if (static_cast<size_t>(op_end - op) < match_length) return false;
+        // Byte-wise, since the match may overlap what it is producing
+        const uint8_t* match = op - offset;
+        for (size_t i = 0; i < match_length; ++i) op[i] = match[i];
+        op += match_length;
+    }
+    return op == op_end;
+}
+
+} // namespace
+
+AssetArchive& AssetArchive::GetInstance() {
+    static AssetArchive instance;
+    return instance;
+}
+
+AssetArchive::AssetArchive() = default;
+
+AssetArchive::~AssetArchive() = default;
+
+bool AssetArchive::Mount(const std::string& path) {
+    auto mapping = std::make_unique<MappedFile>();
+    if (!mapping->Open(path)) {
+        std::cerr << "Failed to map asset archive: " << path << "\n";
+        return false;
+    }
+
+    const uint8_t* data = mapping->data;
+    const size_t size = mapping->size;
+    if (size < header_size || Read32(data) != magic || Read32(data + 4) != version) {
+        std::cerr << "Not a version " << version << " asset archive: " << path << "\n";
+        return false;
+    }
+    const uint32_t count = Read32(data + 8);
+    const uint64_t index_offset = Read64(data + 16);
+    const uint64_t index_size = Read64(data + 24);
+    // Every entry needs at least its fixed part, so count can't exceed what the index holds
+    if (index_offset > size || index_size > size - index_offset || count > index_size / index_entry_size) {
+        std::cerr << "Corrupt asset archive index: " << path << "\n";
+        return false;
+    }
+
+    // Validate the whole index before adding anything
+    std::vector<std::pair<std::string, Entry>> parsed;
+    parsed.reserve(count);
+    const uint8_t* p = data + index_offset;
+    const uint8_t* const index_end = p + index_size;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (static_cast<size_t>(index_end - p) < index_entry_size) break;
+        const uint32_t path_length = Read32(p);
+        Entry entry;
+        entry.flags = Read32(p + 4);
+        const uint64_t offset = Read64(p + 8);
+        entry.stored_size = Read64(p + 16);
+        entry.size = Read64(p + 24);
+        p += index_entry_size;
+        if (static_cast<size_t>(index_end - p) < path_length || offset > size || entry.stored_size > size - offset) {
+            break;
+        }
+        // Raw entries are served straight from the mapping, so size must be the stored size;
+        // compressed ones are decompressed into a buffer of size bytes
+        const bool compressed = entry.flags & flag_lz4;
+        if (entry.size > max_entry_size ||
+            (!compressed && entry.size != entry.stored_size) ||
+            (compressed && entry.size > entry.stored_size * max_lz4_ratio)) {
+            break;
+        }
+        entry.data = data + offset;
+        parsed.emplace_back(std::string(reinterpret_cast<const char*>(p), path_length), entry);
+        p += path_length;
+    }
+    if (parsed.size() != count) {
+        std::cerr << "Corrupt asset archive index: " << path << "\n";
+        return false;
+    }
+
+    for (auto& [entry_path, entry] : parsed) {
+        entries[NormalizePath(entry_path)] = entry;
+    }
+    mappings.push_back(std::move(mapping));
+    std::cout << "Mounted " << path << " (" << count << " entries)\n";
+    return true;
+}
+
+void AssetArchive::UnmountAll() {
+    {
+        std::lock_guard<std::mutex> lock(decompressed_mutex);
+        decompressed.clear();
+    }
+    entries.clear();
+    mappings.clear();
+}
+
+bool AssetArchive::Contains(const std::string& path) const {
+    return !entries.empty() && entries.count(NormalizePath(path)) > 0;
+}
+
+bool AssetArchive::Read(const std::string& path, std::string_view& data) {
+    if (entries.empty()) {
+        return false;
+    }
+    const std::string key = NormalizePath(path);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    const Entry& entry = it->second;
+    if (!(entry.flags & flag_lz4)) {
+        data = std::string_view(reinterpret_cast<const char*>(entry.data), entry.size);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(decompressed_mutex);
+    auto [cached, inserted] = decompressed.try_emplace(key);
+    if (inserted) {
+        cached->second.resize(entry.size);
+        if (!Lz4Decompress(entry.data, entry.stored_size, cached->second.data(), entry.size)) {
+            std::cerr << "Corrupt compressed asset: " << path << "\n";
+            decompressed.erase(cached);
+            return false;
+        }
+    }
+    data = std::string_view(reinterpret_cast<const char*>(cached->second.data()), cached->second.size());
+    return true;
+}
+
+SDL_RWops* AssetArchive::Open(const std::string& path) {
+    std::string_view data;
+    if (Read(path, data)) {
+        // Closing the stream leaves the bytes alone; they belong to the archive
+        return SDL_RWFromConstMem(data.data(), static_cast<int>(data.size()));
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+size_t AssetArchive::GetEntryCount() const {
+    return entries.size();
+}
+
+int AssetArchive::Build(const std::string& output, const std::vector<std::string>& roots, bool compress) {
+    if (output.empty() || roots.empty()) {
+        std::cerr << "Usage: --pack-assets <output> [--lz4] <dir>...\n";
+        return -1;
+    }
+
+    // Paths are stored as they are referenced at runtime, e.g. "assets/enemy.png"
+    std::vector<std::string> files;
+    for (const std::string& root : roots) {
+        std::error_code error;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(root, error)) {
+            if (item.is_regular_file()) {
+                files.push_back(NormalizePath(item.path().generic_string()));
+            }
+        }
+        if (error) {
+            std::cerr << "Failed to read " << root << ": " << error.message() << "\n";
+            return -1;
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to create " << output << "\n";
+        return -1;
+    }
+
+    std::vector<uint8_t> header(header_size, 0);
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+    uint64_t position = header_size;
+
+    std::vector<uint8_t> index;
+    std::vector<uint8_t> compressed;
+    uint64_t total_size = 0;
+    uint64_t total_stored = 0;
+    for (const std::string& file : files) {
+        std::ifstream input(file, std::ios::binary);
+        std::vector<uint8_t> contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        // Keep the compressed form only when it saves a meaningful amount
+        uint32_t flags = 0;
+        const std::vector<uint8_t>* blob = &contents;
+        if (compress && !contents.empty()) {
+            Lz4Compress(contents.data(), contents.size(), compressed);
+            if (compressed.size() < contents.size() - contents.size() / 8) {
+                flags |= flag_lz4;
+                blob = &compressed;
+            }
+        }
+
+        const uint64_t padding = (blob_alignment - position % blob_alignment) % blob_alignment;
+        static const char zeros[blob_alignment] = {};
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        position += padding;
+
+        Write32(index, static_cast<uint32_t>(file.size()));
+        Write32(index, flags);
+        Write64(index, position);
+        Write64(index, blob->size());
+        Write64(index, contents.size());
+        index.insert(index.end(), file.begin(), file.end());
+
+        out.write(reinterpret_cast<const char*>(blob->data()), static_cast<std::streamsize>(blob->size()));
+        position += blob->size();
+        total_size += contents.size();
+        total_stored += blob->size();
+    }
+
+    const uint64_t index_offset = position;
+    out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+    header.clear();
+    Write32(header, magic);
+    Write32(header, version);
+    Write32(header, static_cast<uint32_t>(files.size()));
+    Write32(header, 0);
+    Write64(header, index_offset);
+    Write64(header, index.size());
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+    if (!out) {
+        std::cerr << "Failed to write " << output << "\n";
+        return -1;
+    }
+
+    std::cout << "Packed " << files.size() << " files (" << total_size << " bytes, " << total_stored
+              << " stored) into " << output << "\n";
+    return 0;
+}
+
+void AssetArchive::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table assets_table = lua.create_named_table("Assets");
+    // True if a mounted archive or a loose file provides path
+    assets_table["exists"] = [](const std::string& path) {
+        return AssetArchive::GetInstance().Contains(path) || std::filesystem::exists(path);
+    };
+    assets_table["get_entry_count"] = []() {
+        return AssetArchive::GetInstance().GetEntryCount();
+    };
+}
@@ -0,0 +1,583 @@
+#include <Benchmark.hpp>
+#include <Object.hpp>
+#include <Object2D.hpp>
+#include <TransformSystem.hpp>
+#include <Renderer2D.hpp>
+#include <TextureCache.hpp>
+#include <SDL2/SDL.h>
+#include <RegistryManager.hpp>
+#include <LuaManager.hpp>
+#include <Vector2.hpp>
+#include <SpatialHash2D.hpp>
+#include <JobSystem.hpp>
+#include <ScriptCache.hpp>
+#include <InputSystem.hpp>
+#include <AllocationCounter.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Compare per-frame string lookups of `process` against the cached callbacks
+void LuaCallbacks(int count) {
+    sol::state& lua = LuaManager::GetInstance();
+    constexpr int frames = 100;
+    constexpr float delta = 1.0f / 60.0f;
+
+    const char* script = "counter = 0\nfunction process(delta) counter = counter + delta end";
+
+    auto root = Object::Create();
+    std::vector<std::shared_ptr<Object>> objects;
+    objects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto obj = Object::Create();
+        lua.script(script, obj->GetEnvironment());
+        root->AddChild(obj->entity);
+        objects.push_back(obj);
+    }
+
+    // The old path on plain environments: Object environments now route misses through __index,
+    // which would slow the baseline down
+    std::vector<sol::environment> environments;
+    environments.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        environments.emplace_back(lua, sol::create, lua.globals());
+        lua.script(script, environments.back());
+    }
+
+    double lookup_ms = Benchmark::TimeMs([&]() {
+        for (int frame = 0; frame < frames; ++frame) {
+            for (sol::environment& env : environments) {
+                if (env["process"].valid()) {
+                    env["process"](delta);
+                }
+            }
+        }
+    });
+
+    double cached_ms = Benchmark::TimeMs([&]() {
+        for (int frame = 0; frame < frames; ++frame) {
+            root->Process(delta);
+        }
+    });
+
+    std::cout << "{\"benchmark\":\"lua_callbacks\",\"objects\":" << count
+              << ",\"frames\":" << frames
+              << ",\"lookup_ms\":" << lookup_ms
+              << ",\"cached_ms\":" << cached_ms
+              << ",\"speedup\":" << (cached_ms > 0.0 ? lookup_ms / cached_ms : 0.0)
+              << "}\n";
+
+    environments.clear();
+    objects.clear();
+    RegistryManager::GetInstance().clear();
+}
+
+// Deliver a frame's key events by walking the whole tree vs. through InputSystem's subscribers,
+// for trees of count/100, count/10 and count objects where 1% of objects handle input
+void InputDispatch(int count) {
+    sol::state& lua = LuaManager::GetInstance();
+    constexpr int frames = 100;
+    const SDL_Keycode keys[] = {SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT};
+
+    std::vector<SDL_Event> events;
+    for (SDL_Keycode key : keys) {
+        for (Uint32 type : {SDL_KEYDOWN, SDL_KEYUP}) {
+            SDL_Event event = {};
+            event.type = type;
+            event.key.keysym.sym = key;
+            event.key.keysym.scancode = SDL_GetScancodeFromKey(key);
+            events.push_back(event);
+        }
+    }
+
+    InputSystem& input_system = InputSystem::GetInstance();
+    std::cout << "{\"benchmark\":\"input_dispatch\",\"frames\":" << frames
+              << ",\"events_per_frame\":" << events.size() << ",\"sizes\":[";
+    bool first = true;
+    for (int size : {count / 100, count / 10, count}) {
+        if (size <= 0) {
+            continue;
+        }
+
+        // Random tree: each object hangs under any earlier one
+        auto root = Object::Create();
+        std::vector<std::shared_ptr<Object>> objects = {root};
+        std::vector<std::shared_ptr<Object>> handlers;
+        std::mt19937 rng(1);
+        for (int i = 0; i < size; ++i) {
+            auto obj = Object::Create();
+            std::uniform_int_distribution<size_t> parent(0, objects.size() - 1);
+            objects[parent(rng)]->AddChild(obj->entity);
+            if (i % 100 == 0) {
+                lua.script("handled = 0\nfunction process_input(event) handled = handled + 1 end", obj->GetEnvironment());
+                handlers.push_back(obj);
+            }
+            objects.push_back(obj);
+        }
+
+        double tree_ms = Benchmark::TimeMs([&]() {
+            for (int frame = 0; frame < frames; ++frame) {
+                for (const SDL_Event& event : events) {
+                    root->ProcessInput(event);
+                }
+            }
+        });
+
+        double system_ms = Benchmark::TimeMs([&]() {
+            for (int frame = 0; frame < frames; ++frame) {
+                input_system.ClearEvents();
+                for (const SDL_Event& event : events) {
+                    input_system.PushEvent(event);
+                }
+                input_system.Dispatch();
+            }
+        });
+        input_system.ClearEvents();
+
+        // Both paths must reach every handler the same number of times
+        bool deliveries_match = true;
+        for (auto& handler : handlers) {
+            int handled = handler->GetEnvironment()["handled"];
+            deliveries_match = deliveries_match && handled == 2 * frames * static_cast<int>(events.size());
+        }
+
+        std::cout << (first ? "" : ",")
+                  << "{\"objects\":" << size
+                  << ",\"handlers\":" << handlers.size()
+                  << ",\"tree_ms\":" << tree_ms
+                  << ",\"system_ms\":" << system_ms
+                  << ",\"speedup\":" << (system_ms > 0.0 ? tree_ms / system_ms : 0.0)
+                  << ",\"deliveries_match\":" << (deliveries_match ? "true" : "false")
+                  << "}";
+        first = false;
+
+        handlers.clear();
+        objects.clear();
+        root.reset();
+        RegistryManager::GetInstance().clear();
+        lua.collect_garbage();
+    }
+    std::cout << "]}\n";
+}
+
+// Heap allocations per spawn as JSON, or null when the build doesn't count them
+std::string HeapAllocsPerSpawn(uint64_t allocations, double spawns) {
+    if (!AllocationCounter::counts_heap) {
+        return "null";
+    }
+    return std::to_string(allocations / spawns);
+}
+
+// Spawn and despawn count sprite objects from Lua for several rounds, reporting heap and Lua
+// allocations per spawn; the warm averages skip the rounds that fill the pools.
+// Heap allocations are only counted in builds with ROGUE_COUNT_ALLOCATIONS.
+void SpawnDespawn(int count) {
+    sol::state& lua = LuaManager::GetInstance();
+    constexpr int rounds = 10;
+    constexpr int warmup_rounds = 2;
+
+    auto root = Object::Create();
+    root->GetEnvironment()["bench_count"] = count;
+    lua.script(R"(
+        function spawn()
+            for i = 1, bench_count do
+                local obj = Object2D.new()
+                add_child(obj)
+                obj.add_component(SpriteComponent.new("assets/enemy.png"))
+                obj.set_global_position(i, i)
+                obj.queue_free()
+            end
+        end
+    )", root->GetEnvironment());
+    sol::protected_function spawn = root->GetEnvironment()["spawn"];
+
+    AllocationCounter::InstallLuaCounter(lua.lua_state());
+    uint64_t warm_heap_allocs = 0;
+    uint64_t warm_lua_allocs = 0;
+
+    std::cout << "{\"benchmark\":\"spawn_despawn\",\"spawns_per_round\":" << count << ",\"rounds\":[";
+    for (int round = 0; round < rounds; ++round) {
+        const ObjectPoolStats before = GetObjectPoolStats();
+        const size_t envs_created = EnvironmentPool::GetCreatedCount();
+        const size_t envs_reused = EnvironmentPool::GetReusedCount();
+        const double lua_kb = lua.memory_used() / 1024.0;
+        const uint64_t heap_allocs = AllocationCounter::GetHeapAllocations();
+        const uint64_t lua_allocs = AllocationCounter::GetLuaAllocations();
+
+        double spawn_ms = Benchmark::TimeMs([&]() { spawn(); });
+        double despawn_ms = Benchmark::TimeMs([&]() { Object::DestroyQueued(); });
+        // Released environments return to the pool once Lua finalizes them
+        double gc_ms = Benchmark::TimeMs([&]() { lua.collect_garbage(); });
+
+        const uint64_t round_heap_allocs = AllocationCounter::GetHeapAllocations() - heap_allocs;
+        const uint64_t round_lua_allocs = AllocationCounter::GetLuaAllocations() - lua_allocs;
+        if (round >= warmup_rounds) {
+            warm_heap_allocs += round_heap_allocs;
+            warm_lua_allocs += round_lua_allocs;
+        }
+
+        const ObjectPoolStats& after = GetObjectPoolStats();
+        std::cout << (round ? "," : "")
+                  << "{\"spawn_ms\":" << spawn_ms
+                  << ",\"despawn_ms\":" << despawn_ms
+                  << ",\"gc_ms\":" << gc_ms
+                  << ",\"spawns_per_sec\":" << (spawn_ms > 0.0 ? count * 1000.0 / spawn_ms : 0.0)
+                  << ",\"heap_allocs_per_spawn\":" << HeapAllocsPerSpawn(round_heap_allocs, count)
+                  << ",\"lua_allocs_per_spawn\":" << static_cast<double>(round_lua_allocs) / count
+                  << ",\"pool_reuses\":" << after.reuses - before.reuses
+                  << ",\"envs_created\":" << EnvironmentPool::GetCreatedCount() - envs_created
+                  << ",\"envs_reused\":" << EnvironmentPool::GetReusedCount() - envs_reused
+                  << ",\"lua_kb_delta\":" << lua.memory_used() / 1024.0 - lua_kb
+                  << "}";
+    }
+    const double warm_spawns = static_cast<double>(count) * (rounds - warmup_rounds);
+    std::cout << "],\"warmup_rounds\":" << warmup_rounds
+              << ",\"warm_heap_allocs_per_spawn\":" << HeapAllocsPerSpawn(warm_heap_allocs, warm_spawns)
+              << ",\"warm_lua_allocs_per_spawn\":" << warm_lua_allocs / warm_spawns
+              << "}\n";
+    AllocationCounter::UninstallLuaCounter(lua.lua_state());
+
+    root.reset();
+    RegistryManager::GetInstance().clear();
+}
+
+// Load scripts/main.lua, spawn count sprites and time each phase of a headless frame
+void Scene(int count) {
+    sol::state& lua = LuaManager::GetInstance();
+    constexpr int frames = 300;
+    constexpr float delta = 1.0f / 60.0f;
+
+    if (SDL_Init(SDL_INIT_EVENTS) != 0) {
+        std::cerr << "SDL Init Failed: " << SDL_GetError() << "\n";
+        return;
+    }
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 800, 600, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::cerr << "Failed to create headless renderer: " << SDL_GetError() << "\n";
+        if (surface) SDL_FreeSurface(surface);
+        SDL_Quit();
+        return;
+    }
+    Renderer2D::GetInstance().Initialize(renderer);
+
+    auto root = Object::Create();
+    root->SetScript("scripts/main.lua");
+    root->GetEnvironment()["bench_count"] = count;
+    lua.script(R"(
+        math.randomseed(1)
+        for i = 1, bench_count do
+            local obj = Object2D.new()
+            world.add_child(obj)
+            obj.add_component(SpriteComponent.new("assets/enemy.png"))
+            obj.set_global_position(math.random(-1000, 1000), math.random(-1000, 1000))
+        end
+    )", root->GetEnvironment());
+
+    // A key release every frame exercises the full input dispatch path
+    SDL_Event event = {};
+    event.type = SDL_KEYUP;
+    event.key.keysym.sym = SDLK_UNKNOWN;
+
+    auto& registry = RegistryManager::GetInstance();
+    double input_ms = 0.0, process_ms = 0.0, transform_ms = 0.0, render_ms = 0.0;
+    long long draw_calls = 0;
+    long long visible = 0, culled = 0;
+
+    // Request every texture and let the loaders finish, so timings reflect steady-state frames
+    TransformSystem::GetInstance().Update();
+    Renderer2D::GetInstance().Render(delta);
+    TextureCache::GetInstance().WaitForDecodes();
+
+    for (int frame = 0; frame < frames; ++frame) {
+        JobSystem::GetInstance().BeginFrame();
+        input_ms += Benchmark::TimeMs([&]() {
+            InputSystem::GetInstance().ClearEvents();
+            InputSystem::GetInstance().PushEvent(event);
+            InputSystem::GetInstance().Dispatch();
+        });
+        process_ms += Benchmark::TimeMs([&]() {
+            root->Process(delta);
+        });
+        transform_ms += Benchmark::TimeMs([&]() {
+            TransformSystem::GetInstance().Update();
+        });
+        render_ms += Benchmark::TimeMs([&]() {
+            Renderer2D::GetInstance().Render(delta);
+            SDL_RenderPresent(renderer);
+        });
+        draw_calls += Renderer2D::GetInstance().GetDrawCalls();
+        visible += Renderer2D::GetInstance().GetVisibleCount();
+        culled += Renderer2D::GetInstance().GetCulledCount();
+    }
+
+    std::cout << "{\"benchmark\":\"scene\",\"entities\":" << count
+              << ",\"frames\":" << frames
+              << ",\"draw_calls_per_frame\":" << static_cast<double>(draw_calls) / frames
+              << ",\"visible_per_frame\":" << static_cast<double>(visible) / frames
+              << ",\"culled_per_frame\":" << static_cast<double>(culled) / frames
+              << ",\"phases_ms\":{"
+              << "\"input\":" << input_ms / frames
+              << ",\"process\":" << process_ms / frames
+              << ",\"transform\":" << transform_ms / frames
+              << ",\"render\":" << render_ms / frames
+              << "},\"frame_ms\":" << (input_ms + process_ms + transform_ms + render_ms) / frames
+              << "}\n";
+
+    root.reset();
+    registry.clear();
+    TextureCache::GetInstance().Clear();
+    Renderer2D::GetInstance().Shutdown();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+}
+
+// Old Vector2 layout: a Lua registry reference in every value
+struct LegacyVector2 {
+    float x = 0.0f, y = 0.0f;
+    sol::userdata lua_instance;
+
+    LegacyVector2() = default;
+    LegacyVector2(float x, float y) : x(x), y(y) {}
+    LegacyVector2 operator+(const LegacyVector2& other) const { return LegacyVector2(x + other.x, y + other.y); }
+    LegacyVector2 operator*(float scalar) const { return LegacyVector2(x * scalar, y * scalar); }
+};
+
+// Integrate and copy count positions with the old and new Vector2 layouts,
+// then time TransformSystem::Update over count transforms
+void VectorMath(int count) {
+    constexpr int iterations = 100;
+    constexpr float delta = 1.0f / 60.0f;
+
+    auto integrate = [&](auto& positions, auto& velocities, auto& previous) {
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < count; ++i) {
+                previous[i] = positions[i];
+                positions[i] = positions[i] + velocities[i] * delta;
+            }
+        }
+    };
+
+    std::vector<LegacyVector2> legacy_positions(count), legacy_velocities(count, LegacyVector2(1.0f, 2.0f)), legacy_previous(count);
+    double legacy_ms = Benchmark::TimeMs([&]() { integrate(legacy_positions, legacy_velocities, legacy_previous); });
+
+    std::vector<Vector2> positions(count), velocities(count, Vector2(1.0f, 2.0f)), previous(count);
+    double pod_ms = Benchmark::TimeMs([&]() { integrate(positions, velocities, previous); });
+
+    // Keep the results alive so the loops are not optimized out
+    float checksum = legacy_positions[count - 1].x + positions[count - 1].x;
+
+    auto root = Object2D::Create();
+    std::vector<std::shared_ptr<Object2D>> objects;
+    objects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto obj = Object2D::Create();
+        root->AddChild(obj->entity);
+        objects.push_back(obj);
+    }
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    transforms.Update();
+
+    double transform_ms = Benchmark::TimeMs([&]() {
+        for (int it = 0; it < iterations; ++it) {
+            transforms.SetPosition(root->entity, Vector2(static_cast<float>(it), 0.0f));
+            transforms.Update();
+        }
+    });
+
+    const double ops = static_cast<double>(count) * iterations;
+    std::cout << "{\"benchmark\":\"vector_math\",\"count\":" << count
+              << ",\"iterations\":" << iterations
+              << ",\"legacy_sizeof\":" << sizeof(LegacyVector2)
+              << ",\"pod_sizeof\":" << sizeof(Vector2)
+              << ",\"legacy_ns_per_op\":" << legacy_ms * 1e6 / ops
+              << ",\"pod_ns_per_op\":" << pod_ms * 1e6 / ops
+              << ",\"speedup\":" << (pod_ms > 0.0 ? legacy_ms / pod_ms : 0.0)
+              << ",\"transform_ns_per_entity\":" << transform_ms * 1e6 / ops
+              << ",\"checksum\":" << checksum
+              << "}\n";
+
+    objects.clear();
+    root.reset();
+    RegistryManager::GetInstance().clear();
+}
+
+// Build, incrementally update and query a grid of count entities at constant density,
+// comparing radius queries against a brute-force scan
+void SpatialHash(int count) {
+    constexpr int frames = 60;
+    constexpr int queries = 1000;
+    constexpr float query_radius = 100.0f;
+    constexpr float ray_length = 500.0f;
+
+    auto& registry = RegistryManager::GetInstance();
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    SpatialHash2D& grid = SpatialHash2D::GetInstance();
+
+    const float extent = std::sqrt(static_cast<float>(count)) * 32.0f;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coordinate(-extent, extent);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    // Bare transforms: measures the index, not Object/Lua construction
+    std::vector<entt::entity> entities(count);
+    for (auto& entity : entities) {
+        entity = registry.create();
+        registry.emplace<Transform2D>(entity).position = Vector2(coordinate(rng), coordinate(rng));
+        registry.emplace<Object2DTag>(entity);
+        grid.SetExtents(entity, Vector2(8.0f, 8.0f));
+    }
+    transforms.Update();
+    double build_ms = Benchmark::TimeMs([&]() { grid.Update(); });
+
+    // Move a tenth of the entities each frame
+    auto& transform_storage = registry.storage<Transform2D>();
+    const int movers = std::max(1, count / 10);
+    double update_ms = 0.0;
+    size_t rebucketed = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < movers; ++i) {
+            Transform2D& transform = transform_storage.get(entities[(frame * movers + i) % count]);
+            transform.position = transform.position + Vector2(4.0f, -4.0f);
+        }
+        transforms.Update();
+        update_ms += Benchmark::TimeMs([&]() { grid.Update(); });
+        rebucketed += grid.GetStats().rebucketed;
+    }
+
+    std::vector<Vector2> points(queries), directions(queries);
+    for (int i = 0; i < queries; ++i) {
+        points[i] = Vector2(coordinate(rng), coordinate(rng));
+        float a = angle(rng);
+        directions[i] = Vector2(std::cos(a), std::sin(a));
+    }
+
+    std::vector<entt::entity> results;
+    std::vector<RaycastHit> hits;
+    size_t radius_results = 0, brute_results = 0, aabb_results = 0, ray_hits = 0;
+
+    double radius_ms = Benchmark::TimeMs([&]() {
+        for (const Vector2& point : points) {
+            results.clear();
+            grid.QueryRadius(point, query_radius, results);
+            radius_results += results.size();
+        }
+    });
+    double aabb_ms = Benchmark::TimeMs([&]() {
+        const Vector2 half(query_radius, query_radius);
+        for (const Vector2& point : points) {
+            results.clear();
+            grid.QueryAABB(point - half, point + half, results);
+            aabb_results += results.size();
+        }
+    });
+    double ray_ms = Benchmark::TimeMs([&]() {
+        for (int i = 0; i < queries; ++i) {
+            hits.clear();
+            grid.Raycast(points[i], directions[i], ray_length, hits);
+            ray_hits += hits.size();
+        }
+    });
+    double brute_ms = Benchmark::TimeMs([&]() {
+        auto view = registry.view<SpatialProxy>();
+        for (const Vector2& point : points) {
+            for (auto [entity, proxy] : view.each()) {
+                Vector2 offset = point - Vector2::Clamp(point, proxy.min, proxy.max);
+                if (offset.x * offset.x + offset.y * offset.y <= query_radius * query_radius) {
+                    ++brute_results;
+                }
+            }
+        }
+    });
+
+    std::cout << "{\"benchmark\":\"spatial_hash\",\"entities\":" << count
+              << ",\"cell_size\":" << grid.GetCellSize()
+              << ",\"build_ms\":" << build_ms
+              << ",\"update_ms_per_frame\":" << update_ms / frames
+              << ",\"rebucketed_per_frame\":" << static_cast<double>(rebucketed) / frames
+              << ",\"radius_us\":" << radius_ms * 1000.0 / queries
+              << ",\"aabb_us\":" << aabb_ms * 1000.0 / queries
+              << ",\"ray_us\":" << ray_ms * 1000.0 / queries
+              << ",\"brute_radius_us\":" << brute_ms * 1000.0 / queries
+              << ",\"radius_results\":" << static_cast<double>(radius_results) / queries
+              << ",\"brute_results\":" << static_cast<double>(brute_results) / queries
+              << ",\"aabb_results\":" << static_cast<double>(aabb_results) / queries
+              << ",\"ray_hits\":" << static_cast<double>(ray_hits) / queries
+              << "}\n";
+
+    registry.clear();
+}
+
+// Run a shared script into count fresh environments, re-parsing it each time versus the bytecode cache
+void ScriptLoad(int count) {
+    sol::state& lua = LuaManager::GetInstance();
+    const std::string path = "scripts/state_machine.lua";
+    ScriptCache& cache = ScriptCache::GetInstance();
+    cache.Invalidate(path);
+
+    double source_ms = Benchmark::TimeMs([&]() {
+        for (int i = 0; i < count; ++i) {
+            sol::environment env(lua, sol::create, lua.globals());
+            lua.script_file(path, env);
+        }
+    });
+
+    const ScriptCacheStats before = cache.GetStats();
+    double cached_ms = Benchmark::TimeMs([&]() {
+        for (int i = 0; i < count; ++i) {
+            sol::environment env(lua, sol::create, lua.globals());
+            cache.Run(path, env);
+        }
+    });
+    const ScriptCacheStats& after = cache.GetStats();
+
+    std::cout << "{\"benchmark\":\"script_load\",\"instances\":" << count
+              << ",\"source_ms\":" << source_ms
+              << ",\"cached_ms\":" << cached_ms
+              << ",\"speedup\":" << (cached_ms > 0.0 ? source_ms / cached_ms : 0.0)
+              << ",\"compiles\":" << after.compiles - before.compiles
+              << ",\"disk_hits\":" << after.disk_hits - before.disk_hits
+              << "}\n";
+    lua.collect_garbage();
+}
+
+} // namespace
+
+const std::map<std::string, std::pair<int, Benchmark::Function>>& Benchmark::GetBenchmarks() {
+    // Name -> (default count, benchmark)
+    static const std::map<std::string, std::pair<int, Function>> benchmarks = {
+        {"input_dispatch", {10000, InputDispatch}},
+        {"lua_callbacks", {10000, LuaCallbacks}},
+        {"scene", {1000, Scene}},
+        {"script_load", {1000, ScriptLoad}},
+        {"spatial_hash", {10000, SpatialHash}},
+        {"spawn_despawn", {1000, SpawnDespawn}},
+        {"vector_math", {10000, VectorMath}},
+    };
+    return benchmarks;
+}
+
+int Benchmark::Run(const std::string& name, int count) {
+    const auto& benchmarks = GetBenchmarks();
+    auto it = benchmarks.find(name);
+    if (it == benchmarks.end()) {
+        std::cerr << "Unknown benchmark: " << name << "\n";
+        List();
+        return -1;
+    }
+
+    it->second.second(count > 0 ? count : it->second.first);
+    return 0;
+}
+
+void Benchmark::List() {
+    std::cerr << "Available benchmarks:\n";
+    for (const auto& [name, entry] : GetBenchmarks()) {
+        std::cerr << "- " << name << " (default count " << entry.first << ")\n";
+    }
+}
@@ -0,0 +1,110 @@
+#include <GameLoop.hpp>
+#include <cmath>
+#include <thread>
+
+GameLoop::GameLoop(const GameLoopSettings& settings) : settings(settings) {
+    if (this->settings.fixed_step <= 0.0f) {
+        throw std::invalid_argument("Fixed step must be greater than 0");
+    }
+    if (this->settings.max_steps_per_frame < 1) {
+        this->settings.max_steps_per_frame = 1;
+    }
+}
+
+void GameLoop::Run(const InputFunction& input, const UpdateFunction& update, const RenderFunction& render) {
+    using Seconds = std::chrono::duration<double>;
+
+    const double fixed_step = settings.fixed_step;
+    const auto frame_budget = settings.target_fps > 0
+        ? std::chrono::duration_cast<Clock::duration>(Seconds(1.0 / settings.target_fps))
+        : Clock::duration::zero();
+
+    double accumulator = 0.0;
+    auto previous_time = Clock::now();
+    running = true;
+
+    while (running) {
+        auto frame_start = Clock::now();
+        double frame_time = Seconds(frame_start - previous_time).count();
+        previous_time = frame_start;
+        accumulator += settings.lockstep ? fixed_step : frame_time;
+
+        if (!input()) {
+            running = false;
+            break;
+        }
+
+        if (step_count) {
+            const int forced_steps = step_count();
+            for (int i = 0; i < forced_steps; ++i) {
+                update(settings.fixed_step);
+                ++simulated_frames;
+            }
+            accumulator = 0.0;
+            render(0.0f, static_cast<float>(frame_time));
+            ++rendered_frames;
+            if (frame_budget > Clock::duration::zero()) {
+                WaitUntil(frame_start + frame_budget);
+            }
+            continue;
+        }
+
+        // Advance the simulation in fixed steps, capped so a slow frame cannot spiral
+        int steps = 0;
+        while (accumulator >= fixed_step && steps < settings.max_steps_per_frame) {
+            update(settings.fixed_step);
+            accumulator -= fixed_step;
+            ++steps;
+            ++simulated_frames;
+        }
+        if (accumulator >= fixed_step) {
+            double remainder = std::fmod(accumulator, fixed_step);
+            dropped_time += accumulator - remainder;
+            accumulator = remainder;
+        }
+
+        render(static_cast<float>(accumulator / fixed_step), static_cast<float>(frame_time));
+        ++rendered_frames;
+
+        if (frame_budget > Clock::duration::zero()) {
+            WaitUntil(frame_start + frame_budget);
+        }
+    }
+}
+
+void GameLoop::WaitUntil(Clock::time_point deadline) const {
+    if (!settings.spin_wait) {
+        std::this_thread::sleep_until(deadline);
+        return;
+    }
+
+    // Sleep for the bulk of the wait, then spin the tail to avoid scheduler oversleep
+    auto spin_start = deadline - std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(settings.spin_threshold));
+    if (Clock::now() < spin_start) {
+        std::this_thread::sleep_until(spin_start);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void GameLoop::Stop() {
+    running = false;
+}
+
+void GameLoop::SetStepCount(StepCountFunction step_count) {
+    this->step_count = std::move(step_count);
+}
+
+uint64_t GameLoop::GetSimulatedFrames() const {
+    return simulated_frames;
+}
+
+uint64_t GameLoop::GetRenderedFrames() const {
+    return rendered_frames;
+}
+
+double GameLoop::GetDroppedTime() const {
+    return dropped_time;
+}
@@ -0,0 +1,379 @@
+#include <InputRecorder.hpp>
+#include <InputSystem.hpp>
+#include <InputComponent.hpp>
+#include <Logger.hpp>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+constexpr uint8_t flag_keyboard = 1;
+constexpr uint8_t flag_events = 2;
+constexpr size_t header_size = 12;
+
+void Write32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Zigzag so small negative values stay short
+void WriteSigned(std::vector<uint8_t>& out, int64_t value) {
+    WriteVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Bounds-checked reader over the replay file
+struct Reader {
+    const std::vector<uint8_t>& data;
+    size_t& offset;
+    bool ok = true;
+
+    uint64_t Varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset >= data.size()) {
+                ok = false;
+                return 0;
+            }
+            uint8_t byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t Signed() {
+        uint64_t value = Varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint8_t Byte() {
+        if (offset >= data.size()) {
+            ok = false;
+            return 0;
+        }
+        return data[offset++];
+    }
+};
+
+void WriteEvent(std::vector<uint8_t>& out, const SDL_Event& event) {
+    WriteVarint(out, event.type);
+    WriteVarint(out, event.common.timestamp);
+    switch (event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        WriteSigned(out, event.key.keysym.sym);
+        WriteVarint(out, event.key.keysym.scancode);
+        WriteVarint(out, event.key.keysym.mod);
+        WriteVarint(out, event.key.state);
+        WriteVarint(out, event.key.repeat);
+        break;
+    case SDL_MOUSEMOTION:
+        WriteVarint(out, event.motion.which);
+        WriteVarint(out, event.motion.state);
+        WriteSigned(out, event.motion.x);
+        WriteSigned(out, event.motion.y);
+        WriteSigned(out, event.motion.xrel);
+        WriteSigned(out, event.motion.yrel);
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        WriteVarint(out, event.button.which);
+        WriteVarint(out, event.button.button);
+        WriteVarint(out, event.button.state);
+        WriteVarint(out, event.button.clicks);
+        WriteSigned(out, event.button.x);
+        WriteSigned(out, event.button.y);
+        break;
+    case SDL_MOUSEWHEEL:
+        WriteVarint(out, event.wheel.which);
+        WriteSigned(out, event.wheel.x);
+        WriteSigned(out, event.wheel.y);
+        WriteVarint(out, event.wheel.direction);
+        break;
+    case SDL_TEXTINPUT: {
+        size_t length = strnlen(event.text.text, SDL_TEXTINPUTEVENT_TEXT_SIZE - 1);
+        WriteVarint(out, length);
+        out.insert(out.end(), event.text.text, event.text.text + length);
+        break;
+    }
+    default: // SDL_QUIT has no payload
+        break;
+    }
+}
+
+bool ReadEvent(Reader& in, SDL_Event& event) {
+    event = {};
+    event.type = static_cast<Uint32>(in.Varint());
+    event.common.timestamp = static_cast<Uint32>(in.Varint());
+    switch (event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        event.key.keysym.sym = static_cast<SDL_Keycode>(in.Signed());
+        event.key.keysym.scancode = static_cast<SDL_Scancode>(in.Varint());
+        event.key.keysym.mod = static_cast<Uint16>(in.Varint());
+        event.key.state = static_cast<Uint8>(in.Varint());
+        event.key.repeat = static_cast<Uint8>(in.Varint());
+        break;
+    case SDL_MOUSEMOTION:
+        event.motion.which = static_cast<Uint32>(in.Varint());
+        event.motion.state = static_cast<Uint32>(in.Varint());
+        event.motion.x = static_cast<Sint32>(in.Signed());
+        event.motion.y = static_cast<Sint32>(in.Signed());
+        event.motion.xrel = static_cast<Sint32>(in.Signed());
+        event.motion.yrel = static_cast<Sint32>(in.Signed());
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        event.button.which = static_cast<Uint32>(in.Varint());
+        event.button.button = static_cast<Uint8>(in.Varint());
+        event.button.state = static_cast<Uint8>(in.Varint());
+        event.button.clicks = static_cast<Uint8>(in.Varint());
+        event.button.x = static_cast<Sint32>(in.Signed());
+        event.button.y = static_cast<Sint32>(in.Signed());
+        break;
+    case SDL_MOUSEWHEEL:
+        event.wheel.which = static_cast<Uint32>(in.Varint());
+        event.wheel.x = static_cast<Sint32>(in.Signed());
+        event.wheel.y = static_cast<Sint32>(in.Signed());
+        event.wheel.direction = static_cast<Uint32>(in.Varint());
+        break;
+    case SDL_TEXTINPUT: {
+        uint64_t length = in.Varint();
+        if (length >= SDL_TEXTINPUTEVENT_TEXT_SIZE) {
+            return false;
+        }
+        for (uint64_t i = 0; i < length; ++i) {
+            event.text.text[i] = static_cast<char>(in.Byte());
+        }
+        break;
+    }
+    case SDL_QUIT:
+        break;
+    default:
+        return false;
+    }
+    return in.ok;
+}
+
+bool IsRecorded(Uint32 type) {
+    switch (type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    case SDL_MOUSEWHEEL:
+    case SDL_TEXTINPUT:
+    case SDL_QUIT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+InputRecorder& InputRecorder::GetInstance() {
+    static InputRecorder instance;
+    return instance;
+}
+
+InputRecorder::~InputRecorder() {
+    if (mode == Mode::Recording) {
+        Stop(pending_tick);
+    }
+}
+
+bool InputRecorder::StartRecording(const std::string& file_path, float fixed_step) {
+    output.open(file_path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        Logger::Error(LogCategory::General, "Failed to open input recording: ", file_path);
+        return false;
+    }
+    std::vector<uint8_t> header;
+    Write32(header, magic);
+    Write32(header, version);
+    uint32_t step_bits;
+    std::memcpy(&step_bits, &fixed_step, sizeof(step_bits));
+    Write32(header, step_bits);
+    output.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    mode = Mode::Recording;
+    path = file_path;
+    frames = 0;
+    has_pending = false;
+    recorded_keys.reset();
+    Logger::Info(LogCategory::General, "Recording input to ", file_path);
+    return true;
+}
+
+bool InputRecorder::StartReplay(const std::string& file_path, float fixed_step) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) {
+        Logger::Error(LogCategory::General, "Failed to open input replay: ", file_path);
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    auto read32 = [this](size_t at) {
+        return static_cast<uint32_t>(data[at]) | static_cast<uint32_t>(data[at + 1]) << 8 |
+               static_cast<uint32_t>(data[at + 2]) << 16 | static_cast<uint32_t>(data[at + 3]) << 24;
+    };
+    if (data.size() < header_size || read32(0) != magic || read32(4) != version) {
+        Logger::Error(LogCategory::General, "Not an input recording (version ", version, "): ", file_path);
+        data.clear();
+        return false;
+    }
+    uint32_t step_bits = read32(8);
+    float recorded_step;
+    std::memcpy(&recorded_step, &step_bits, sizeof(recorded_step));
+    if (std::fabs(recorded_step - fixed_step) > 1e-6f) {
+        Logger::Warning(LogCategory::General, "Input recording used a ", recorded_step, "s step, replaying with ",
+                        fixed_step, "s; the simulation will diverge");
+    }
+
+    mode = Mode::Replaying;
+    path = file_path;
+    frames = 0;
+    offset = header_size;
+    replay_steps = 0;
+    replay_keys.reset();
+    Logger::Info(LogCategory::General, "Replaying input from ", file_path);
+    return true;
+}
+
+void InputRecorder::Stop(uint64_t simulated_frames) {
+    if (mode == Mode::Recording) {
+        FlushPending(simulated_frames);
+        output.close();
+        Logger::Info(LogCategory::General, "Recorded ", frames, " input frames to ", path);
+    } else if (mode == Mode::Replaying) {
+        data.clear();
+        data.shrink_to_fit();
+    }
+    mode = Mode::Idle;
+}
+
+bool InputRecorder::IsRecording() const {
+    return mode == Mode::Recording;
+}
+
+bool InputRecorder::IsReplaying() const {
+    return mode == Mode::Replaying;
+}
+
+uint64_t InputRecorder::GetFrameCount() const {
+    return frames;
+}
+
+int InputRecorder::GetReplaySteps() const {
+    return replay_steps;
+}
+
+void InputRecorder::FlushPending(uint64_t simulated_frames) {
+    if (!has_pending) {
+        return;
+    }
+    std::vector<uint8_t> frame;
+    WriteVarint(frame, simulated_frames - pending_tick);
+    frame.insert(frame.end(), pending.begin(), pending.end());
+    output.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+    has_pending = false;
+    ++frames;
+}
+
+void InputRecorder::RecordFrame(const InputSystem& input, uint64_t simulated_frames) {
+    if (mode != Mode::Recording) {
+        return;
+    }
+    FlushPending(simulated_frames);
+
+    pending.clear();
+    const std::bitset<SDL_NUM_SCANCODES>& keys = InputComponent::GetKeyboardState();
+    size_t recorded_events = 0;
+    for (const SDL_Event& event : input.GetEvents()) {
+        recorded_events += IsRecorded(event.type) ? 1 : 0;
+    }
+
+    uint8_t flags = (keys != recorded_keys ? flag_keyboard : 0) | (recorded_events > 0 ? flag_events : 0);
+    pending.push_back(flags);
+    if (flags & flag_keyboard) {
+        WriteVarint(pending, keys.count());
+        for (size_t scancode = 0; scancode < keys.size(); ++scancode) {
+            if (keys[scancode]) {
+                WriteVarint(pending, scancode);
+            }
+        }
+        recorded_keys = keys;
+    }
+    if (flags & flag_events) {
+        WriteVarint(pending, recorded_events);
+        for (const SDL_Event& event : input.GetEvents()) {
+            if (IsRecorded(event.type)) {
+                WriteEvent(pending, event);
+            }
+        }
+    }
+    pending_tick = simulated_frames;
+    has_pending = true;
+}
+
+bool InputRecorder::ReplayFrame(InputSystem& input) {
+    if (mode != Mode::Replaying) {
+        return false;
+    }
+    input.ClearEvents();
+    replay_steps = 0;
+    if (offset >= data.size()) {
+        Logger::Info(LogCategory::General, "Input replay finished after ", frames, " frames");
+        Stop(0);
+        return false;
+    }
+
+    Reader in{data, offset};
+    const uint64_t steps = in.Varint();
+    const uint8_t flags = in.Byte();
+    if (flags & flag_keyboard) {
+        replay_keys.reset();
+        const uint64_t count = in.Varint();
+        for (uint64_t i = 0; i < count && in.ok; ++i) {
+            const uint64_t scancode = in.Varint();
+            if (scancode < replay_keys.size()) {
+                replay_keys.set(scancode);
+            }
+        }
+    }
+    if (flags & flag_events) {
+        const uint64_t count = in.Varint();
+        for (uint64_t i = 0; i < count && in.ok; ++i) {
+            SDL_Event event;
+            if (!ReadEvent(in, event)) {
+                in.ok = false;
+                break;
+            }
+            input.PushEvent(event);
+        }
+    }
+    if (!in.ok || steps > static_cast<uint64_t>(INT32_MAX)) {
+        Logger::Error(LogCategory::General, "Input recording is corrupt at frame ", frames, ": ", path);
+        input.ClearEvents();
+        Stop(0);
+        return false;
+    }
+
+    InputComponent::SetKeyboardState(replay_keys);
+    replay_steps = static_cast<int>(steps);
+    ++frames;
+    return true;
+}
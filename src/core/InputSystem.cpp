@@ -0,0 +1,108 @@
+#include <InputSystem.hpp>
+#include <InputComponent.hpp>
+#include <Object.hpp>
+#include <Profiler.hpp>
+
+InputSystem& InputSystem::GetInstance() {
+    static InputSystem instance;
+    return instance;
+}
+
+void InputSystem::Collect() {
+    ProfileZone zone("InputSystem::Collect");
+    events.clear();
+
+    // Pump first so the keyboard snapshot scripts read covers every event dispatched this frame
+    SDL_PumpEvents();
+    InputComponent::SnapshotKeyboard();
+
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        events.push_back(event);
+    }
+}
+
+const std::vector<SDL_Event>& InputSystem::GetEvents() const {
+    return events;
+}
+
+void InputSystem::ClearEvents() {
+    events.clear();
+}
+
+void InputSystem::PushEvent(const SDL_Event& event) {
+    events.push_back(event);
+}
+
+void InputSystem::Subscribe(entt::entity entity) {
+    if (subscribed.insert(entity).second) {
+        subscribers.push_back(entity);
+    }
+}
+
+size_t InputSystem::GetSubscriberCount() const {
+    return subscribers.size();
+}
+
+void InputSystem::RebuildRoutes() {
+    routes.clear();
+    auto view = RegistryManager::GetInstance().view<std::shared_ptr<InputComponent>>();
+    for (auto [owner, input] : view.each()) {
+        for (size_t id = 0; id < input->actions.size(); ++id) {
+            for (const InputComponent::ActionTrigger& trigger : input->actions[id].triggers) {
+                routes[trigger.scancode].push_back({owner, static_cast<int>(id), trigger.event_type});
+            }
+        }
+    }
+    routes_version = InputComponent::GetBindingsVersion();
+}
+
+void InputSystem::Dispatch() {
+    ProfileZone zone("InputSystem::Dispatch");
+    if (events.empty()) {
+        return;
+    }
+    auto& registry = RegistryManager::GetInstance();
+
+    // Drop destroyed objects and ones whose handlers were removed, keeping the order
+    size_t kept = 0;
+    for (entt::entity entity : subscribers) {
+        auto* object = registry.valid(entity) ? registry.try_get<std::shared_ptr<Object>>(entity) : nullptr;
+        if (object && *object && (*object)->HandlesInput()) {
+            subscribers[kept++] = entity;
+        } else {
+            subscribed.erase(entity);
+        }
+    }
+    subscribers.resize(kept);
+
+    if (routes_version != InputComponent::GetBindingsVersion()) {
+        RebuildRoutes();
+    }
+
+    // Handlers may create, subscribe or destroy objects; new subscribers start next frame
+    dispatch_list.assign(subscribers.begin(), subscribers.end());
+    for (const SDL_Event& event : events) {
+        for (entt::entity entity : dispatch_list) {
+            if (auto* object = registry.valid(entity) ? registry.try_get<std::shared_ptr<Object>>(entity) : nullptr) {
+                (*object)->HandleInput(event);
+            }
+        }
+
+        if ((event.type != SDL_KEYDOWN && event.type != SDL_KEYUP) || event.key.repeat) {
+            continue;
+        }
+        auto it = routes.find(event.key.keysym.scancode);
+        if (it == routes.end()) {
+            continue;
+        }
+        for (const ActionRoute& route : it->second) {
+            if (route.event_type != event.type || !registry.valid(route.owner)) {
+                continue;
+            }
+            if (auto* object = registry.try_get<std::shared_ptr<Object>>(route.owner)) {
+                (*object)->HandleAction(route.action_id, event.type == SDL_KEYDOWN);
+            }
+        }
+    }
+}
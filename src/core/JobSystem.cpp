@@ -0,0 +1,301 @@
+#include <JobSystem.hpp>
+#include <Profiler.hpp>
+#include <algorithm>
+
+struct Job {
+    const char* name;
+    std::function<void()> task;
+    Job* parent;                      // Finishes only after this job
+    std::atomic<int> unfinished{1};   // This job plus unfinished children
+    std::atomic<int> pending{1};      // Unfinished dependencies, plus a guard held while scheduling
+    std::mutex mutex;
+    std::vector<Job*> continuations;  // Jobs that depend on this one
+    bool done = false;                // Guarded by mutex
+
+    Job(const char* name, std::function<void()> task, Job* parent)
+        : name(name), task(std::move(task)), parent(parent) {}
+};
+
+namespace {
+
+// Index of the worker running on this thread; -1 for threads outside the pool
+thread_local int current_worker = -1;
+
+} // namespace
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() {
+    queues.push_back(std::make_unique<WorkQueue>());
+    frame_start = std::chrono::steady_clock::now();
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Initialize(int worker_count) {
+    if (running) {
+        std::cerr << "JobSystem is already initialized.\n";
+        return;
+    }
+    if (worker_count < 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        worker_count = hardware > 1 ? static_cast<int>(hardware) - 1 : 0;
+    }
+
+    current_worker = 0;
+    queues.resize(1);
+    for (int i = 0; i < worker_count; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running = true;
+    for (int i = 1; i <= worker_count; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+    frame_start = std::chrono::steady_clock::now();
+}
+
+void JobSystem::Shutdown() {
+    if (!running) {
+        return;
+    }
+    BeginFrame();
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.resize(1);
+}
+
+void JobSystem::BeginFrame() {
+    // Help until everything scheduled last frame is done, so job memory can be recycled
+    while (in_flight.load() > 0) {
+        if (!RunOne(0)) {
+            std::this_thread::yield();
+        }
+    }
+
+    last_frame_trace.clear();
+    for (auto& queue : queues) {
+        last_frame_trace.insert(last_frame_trace.end(), queue->trace.begin(), queue->trace.end());
+        queue->trace.clear();
+    }
+    std::sort(last_frame_trace.begin(), last_frame_trace.end(), [](const JobTraceEvent& lhs, const JobTraceEvent& rhs) {
+        return lhs.start_us < rhs.start_us;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(arena_mutex);
+        arena.clear();
+    }
+    frame_start = std::chrono::steady_clock::now();
+}
+
+Job* JobSystem::Allocate(const char* name, std::function<void()> task, Job* parent) {
+    if (parent) {
+        parent->unfinished.fetch_add(1);
+    }
+    in_flight.fetch_add(1);
+    std::lock_guard<std::mutex> lock(arena_mutex);
+    return &arena.emplace_back(name, std::move(task), parent);
+}
+
+JobHandle JobSystem::Schedule(const char* name, std::function<void()> task, std::initializer_list<JobHandle> dependencies) {
+    Job* job = Allocate(name, std::move(task), nullptr);
+    for (Job* dependency : dependencies) {
+        if (!dependency) continue;
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done) {
+            dependency->continuations.push_back(job);
+            job->pending.fetch_add(1);
+        }
+    }
+
+    // Drop the scheduling guard; queue now unless a dependency is still running
+    if (job->pending.fetch_sub(1) == 1) {
+        Enqueue(job);
+    }
+    return job;
+}
+
+void JobSystem::Enqueue(Job* job) {
+    WorkQueue& queue = *queues[current_worker > 0 && current_worker < static_cast<int>(queues.size()) ? current_worker : 0];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    queued.fetch_add(1);
+
+    // Taking the lock orders this notify after a worker's predicate check
+    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+    wake.notify_one();
+}
+
+Job* JobSystem::Pop(int worker) {
+    const int count = static_cast<int>(queues.size());
+
+    // Own queue: newest first, for cache locality
+    {
+        WorkQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            Job* job = own.jobs.back();
+            own.jobs.pop_back();
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+
+    // Steal the oldest job from another worker
+    for (int i = 1; i < count; ++i) {
+        WorkQueue& victim = *queues[(worker + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            Job* job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::RunOne(int worker) {
+    Job* job = Pop(worker);
+    if (!job) {
+        return false;
+    }
+
+    using Microseconds = std::chrono::duration<double, std::micro>;
+    auto start = std::chrono::steady_clock::now();
+    if (job->task) {
+        job->task();
+    }
+    auto end = std::chrono::steady_clock::now();
+    queues[worker]->trace.push_back({job->name, worker,
+                                     Microseconds(start - frame_start).count(),
+                                     Microseconds(end - frame_start).count()});
+    Profiler::GetInstance().Record(job->name, start, end);
+    Finish(job);
+    return true;
+}
+
+void JobSystem::Finish(Job* job) {
+    if (job->unfinished.fetch_sub(1) != 1) {
+        return;
+    }
+
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done = true;
+        ready.swap(job->continuations);
+    }
+    for (Job* continuation : ready) {
+        if (continuation->pending.fetch_sub(1) == 1) {
+            Enqueue(continuation);
+        }
+    }
+
+    // The job may be recycled once in_flight drops, so read what we need first
+    Job* parent = job->parent;
+    in_flight.fetch_sub(1);
+    if (parent) {
+        Finish(parent);
+    }
+}
+
+void JobSystem::Wait(JobHandle job) {
+    if (!job) {
+        return;
+    }
+    // Threads outside the pool only help when there is nobody else to run the jobs
+    int worker = current_worker >= 0 ? current_worker : (workers.empty() ? 0 : -1);
+    while (job->unfinished.load() > 0) {
+        if (worker < 0 || !RunOne(worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(const char* name, size_t count, size_t grain, const std::function<void(size_t, size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || count <= grain) {
+        func(0, count);
+        return;
+    }
+
+    // The root is never queued; it finishes when its last chunk does
+    Job* root = Allocate(name, nullptr, nullptr);
+    for (size_t begin = 0; begin < count; begin += grain) {
+        size_t end = std::min(begin + grain, count);
+        Enqueue(Allocate(name, [&func, begin, end]() { func(begin, end); }, root));
+    }
+    Finish(root);
+    Wait(root);
+}
+
+void JobSystem::WorkerLoop(int worker) {
+    current_worker = worker;
+    Profiler::SetThreadName("worker " + std::to_string(worker));
+    while (running) {
+        if (!RunOne(worker)) {
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this]() { return queued.load() > 0 || !running; });
+        }
+    }
+}
+
+int JobSystem::GetWorkerCount() const {
+    return static_cast<int>(workers.size());
+}
+
+const std::vector<JobTraceEvent>& JobSystem::GetLastFrameTrace() const {
+    return last_frame_trace;
+}
+
+void JobSystem::PrintTrace(std::ostream& out) const {
+    out << "Job trace (" << last_frame_trace.size() << " jobs, " << workers.size() << " workers):\n";
+    for (const JobTraceEvent& event : last_frame_trace) {
+        out << "  worker " << event.worker << "  " << event.name
+            << "  " << event.start_us << " -> " << event.end_us << " us\n";
+    }
+}
+
+void JobSystem::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table jobs_table = lua.create_named_table("Jobs");
+    jobs_table["get_worker_count"] = []() {
+        return JobSystem::GetInstance().GetWorkerCount();
+    };
+    // Returns { { name, worker, start_us, end_us }, ... } for the previous frame
+    jobs_table["get_trace"] = []() {
+        sol::state& lua = LuaManager::GetInstance();
+        const auto& trace = JobSystem::GetInstance().GetLastFrameTrace();
+        sol::table result = lua.create_table(static_cast<int>(trace.size()), 0);
+        for (size_t i = 0; i < trace.size(); ++i) {
+            result[i + 1] = lua.create_table_with(
+                "name", trace[i].name,
+                "worker", trace[i].worker,
+                "start_us", trace[i].start_us,
+                "end_us", trace[i].end_us);
+        }
+        return result;
+    };
+    jobs_table["print_trace"] = []() {
+        JobSystem::GetInstance().PrintTrace(std::cout);
+    };
+}
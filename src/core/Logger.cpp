@@ -0,0 +1,239 @@
+#include <Logger.hpp>
+#include <chrono>
+
+namespace {
+
+// How long the writer sleeps between batches unless woken by an error or Flush
+constexpr std::chrono::milliseconds flush_interval{5};
+
+constexpr const char* level_names[] = {"debug", "info", "warning", "error"};
+constexpr const char* category_names[] = {"general", "lifecycle", "script", "assets"};
+static_assert(sizeof(category_names) / sizeof(category_names[0]) == static_cast<size_t>(LogCategory::Count));
+
+std::ostream& StreamFor(LogLevel level) {
+    return level >= LogLevel::Warning ? std::cerr : std::cout;
+}
+
+} // namespace
+
+Logger& Logger::GetInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() : head(&stub), tail(&stub) {
+    running = true;
+    writer = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger() {
+    Shutdown();
+}
+
+void Logger::SetLevel(LogLevel level) {
+    min_level.store(level, std::memory_order_relaxed);
+}
+
+void Logger::SetCategoryEnabled(LogCategory category, bool enabled) {
+    const uint32_t bit = 1u << static_cast<uint32_t>(category);
+    if (enabled) {
+        category_mask.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        category_mask.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+bool Logger::ParseLevel(const std::string& name, LogLevel& level) {
+    for (size_t i = 0; i < sizeof(level_names) / sizeof(level_names[0]); ++i) {
+        if (name == level_names[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Logger::ParseCategory(const std::string& name, LogCategory& category) {
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::Count); ++i) {
+        if (name == category_names[i]) {
+            category = static_cast<LogCategory>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::Enqueue(LogLevel level, std::string text) {
+    text.push_back('\n');
+    if (!running.load(std::memory_order_acquire)) {
+        StreamFor(level) << text;
+        return;
+    }
+
+    Message* message = new Message;
+    message->level = level;
+    message->text = std::move(text);
+    Push(message);
+    enqueued.fetch_add(1, std::memory_order_release);
+
+    if (level >= LogLevel::Error) {
+        wake_requested.store(true, std::memory_order_relaxed);
+        wake.notify_one();
+    }
+}
+
+void Logger::Push(Message* message) {
+    message->next.store(nullptr, std::memory_order_relaxed);
+    Message* previous = head.exchange(message, std::memory_order_acq_rel);
+    // Between the exchange and this store the message is queued but not yet reachable from tail
+    previous->next.store(message, std::memory_order_release);
+}
+
+Logger::Message* Logger::Pop() {
+    Message* first = tail;
+    Message* next = first->next.load(std::memory_order_acquire);
+    if (first == &stub) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return first;
+    }
+    if (first != head.load(std::memory_order_acquire)) {
+        return nullptr; // A producer is mid-push; pick it up next batch
+    }
+    // first is the last message: requeue the stub behind it so first can be detached
+    Push(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+size_t Logger::Drain() {
+    // Consecutive messages for the same stream are written with one call
+    std::string batch;
+    LogLevel batch_level = LogLevel::Info;
+    size_t count = 0;
+    auto write_batch = [&]() {
+        if (!batch.empty()) {
+            std::ostream& stream = StreamFor(batch_level);
+            stream.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            stream.flush();
+            batch.clear();
+        }
+    };
+
+    while (Message* message = Pop()) {
+        if (&StreamFor(message->level) != &StreamFor(batch_level)) {
+            write_batch();
+        }
+        batch_level = message->level;
+        batch += message->text;
+        delete message;
+        ++count;
+    }
+    write_batch();
+    return count;
+}
+
+void Logger::WriterLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, flush_interval, [this]() {
+                return wake_requested.load(std::memory_order_relaxed) || !running.load(std::memory_order_relaxed);
+            });
+            wake_requested.store(false, std::memory_order_relaxed);
+        }
+        const bool stopping = !running.load(std::memory_order_acquire);
+
+        size_t count = Drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written += count;
+        }
+        drained.notify_all();
+
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void Logger::Flush() {
+    if (!running.load(std::memory_order_acquire)) {
+        return;
+    }
+    const uint64_t target = enqueued.load(std::memory_order_acquire);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake_requested.store(true, std::memory_order_relaxed);
+    }
+    wake.notify_one();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this, target]() {
+        return written >= target || !running.load(std::memory_order_relaxed);
+    });
+}
+
+void Logger::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) {
+            return;
+        }
+        running.store(false, std::memory_order_release);
+    }
+    wake.notify_one();
+    drained.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    // Catch messages pushed while the writer was finishing
+    Drain();
+}
+
+void Logger::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table log_table = lua.create_named_table("Log");
+    log_table["debug"] = [](const std::string& message) {
+        Logger::Debug(LogCategory::Script, message);
+    };
+    log_table["info"] = [](const std::string& message) {
+        Logger::Info(LogCategory::Script, message);
+    };
+    log_table["warning"] = [](const std::string& message) {
+        Logger::Warning(LogCategory::Script, message);
+    };
+    log_table["error"] = [](const std::string& message) {
+        Logger::Error(LogCategory::Script, message);
+    };
+    // Log.set_level("debug" | "info" | "warning" | "error")
+    log_table["set_level"] = [](const std::string& name) {
+        LogLevel level;
+        if (!Logger::ParseLevel(name, level)) {
+            throw sol::error("unknown log level: " + name);
+        }
+        Logger::GetInstance().SetLevel(level);
+    };
+    // Log.set_category_enabled("lifecycle", false)
+    log_table["set_category_enabled"] = [](const std::string& name, bool enabled) {
+        LogCategory category;
+        if (!Logger::ParseCategory(name, category)) {
+            throw sol::error("unknown log category: " + name);
+        }
+        Logger::GetInstance().SetCategoryEnabled(category, enabled);
+    };
+    log_table["flush"] = []() {
+        Logger::GetInstance().Flush();
+    };
+}
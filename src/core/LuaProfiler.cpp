@@ -0,0 +1,199 @@
+#include <LuaProfiler.hpp>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// "chunk:function:line" for Lua frames, "[C]:function" for native ones
+std::string FrameLabel(const lua_Debug& ar) {
+    std::string label;
+    if (ar.what && std::string(ar.what) == "C") {
+        label = std::string("[C]:") + (ar.name ? ar.name : "?");
+    } else if (ar.what && std::string(ar.what) == "main") {
+        label = std::string(ar.short_src) + ":main";
+    } else {
+        label = std::string(ar.short_src) + ":" + (ar.name ? ar.name : "?") + ":" + std::to_string(ar.linedefined);
+    }
+    // ';' separates frames in the folded format
+    std::replace(label.begin(), label.end(), ';', ':');
+    return label;
+}
+
+std::string EntityLabel(uint32_t entity) {
+    return entity == static_cast<uint32_t>(entt::entity(entt::null)) ? "global" : "entity " + std::to_string(entity);
+}
+
+template <typename Key>
+std::vector<std::pair<Key, uint64_t>> SortedByTime(const std::unordered_map<Key, uint64_t>& totals) {
+    std::vector<std::pair<Key, uint64_t>> sorted(totals.begin(), totals.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+    return sorted;
+}
+
+} // namespace
+
+LuaProfiler& LuaProfiler::GetInstance() {
+    static LuaProfiler instance;
+    return instance;
+}
+
+void LuaProfiler::Start(double period_us, int instruction_interval) {
+    period = std::chrono::nanoseconds(static_cast<int64_t>(std::max(period_us, 1.0) * 1000.0));
+    segment_start = std::chrono::steady_clock::now();
+    pending = std::chrono::nanoseconds(0);
+    running = true;
+    lua_sethook(LuaManager::GetInstance().lua_state(), &LuaProfiler::Hook, LUA_MASKCOUNT, std::max(instruction_interval, 1));
+}
+
+void LuaProfiler::Stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    lua_sethook(LuaManager::GetInstance().lua_state(), nullptr, 0, 0);
+}
+
+bool LuaProfiler::IsRunning() const {
+    return running;
+}
+
+void LuaProfiler::Clear() {
+    samples = 0;
+    pending = std::chrono::nanoseconds(0);
+    stack_ns.clear();
+    function_ns.clear();
+    chunk_ns.clear();
+    entity_ns.clear();
+}
+
+LuaProfiler::Scope::Scope(entt::entity entity) {
+    LuaProfiler& profiler = LuaProfiler::GetInstance();
+    previous = profiler.current_entity;
+    profiler.current_entity = entity;
+    if (profiler.scope_depth++ == 0 && profiler.running) {
+        profiler.segment_start = std::chrono::steady_clock::now();
+    }
+}
+
+LuaProfiler::Scope::~Scope() {
+    LuaProfiler& profiler = LuaProfiler::GetInstance();
+    if (--profiler.scope_depth == 0 && profiler.running) {
+        // The tail is charged to whichever stack the next sample lands in
+        profiler.pending += std::chrono::steady_clock::now() - profiler.segment_start;
+    }
+    profiler.current_entity = previous;
+}
+
+void LuaProfiler::Hook(lua_State* L, lua_Debug*) {
+    LuaProfiler& profiler = GetInstance();
+    if (profiler.scope_depth == 0) {
+        return; // Lua run outside any engine callback isn't timed
+    }
+    auto now = std::chrono::steady_clock::now();
+    profiler.pending += now - profiler.segment_start;
+    profiler.segment_start = now;
+    if (profiler.pending >= profiler.period) {
+        profiler.Sample(L, static_cast<uint64_t>(profiler.pending.count()));
+        profiler.pending = std::chrono::nanoseconds(0);
+    }
+}
+
+void LuaProfiler::Sample(lua_State* L, uint64_t weight_ns) {
+    // Innermost frame first
+    std::vector<std::string> frames;
+    std::string leaf_chunk;
+    lua_Debug ar;
+    for (int level = 0; level < max_stack_depth && lua_getstack(L, level, &ar); ++level) {
+        if (!lua_getinfo(L, "Sn", &ar)) {
+            break;
+        }
+        if (level == 0) {
+            leaf_chunk = ar.what && std::string(ar.what) == "C" ? "[C]" : ar.short_src;
+        }
+        frames.push_back(FrameLabel(ar));
+    }
+    if (frames.empty()) {
+        return;
+    }
+
+    const uint32_t entity = static_cast<uint32_t>(current_entity);
+    std::string stack = EntityLabel(entity);
+    for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+        stack += ';';
+        stack += *frame;
+    }
+
+    ++samples;
+    stack_ns[stack] += weight_ns;
+    function_ns[frames.front()] += weight_ns;
+    chunk_ns[leaf_chunk] += weight_ns;
+    entity_ns[entity] += weight_ns;
+}
+
+void LuaProfiler::WriteFolded(std::ostream& out) const {
+    for (const auto& [stack, ns] : SortedByTime(stack_ns)) {
+        out << stack << " " << std::max<uint64_t>(ns / 1000, 1) << "\n";
+    }
+}
+
+bool LuaProfiler::WriteFolded(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write Lua profile: " << path << "\n";
+        return false;
+    }
+    WriteFolded(file);
+    std::cout << "Wrote Lua profile " << path << " (" << samples << " samples, " << stack_ns.size() << " stacks)\n";
+    return static_cast<bool>(file);
+}
+
+void LuaProfiler::PrintReport(std::ostream& out, size_t limit) const {
+    auto print = [&](const char* title, const auto& sorted, auto label) {
+        out << title << ":\n";
+        for (size_t i = 0; i < sorted.size() && i < limit; ++i) {
+            out << "  " << sorted[i].second / 1000000.0 << " ms  " << label(sorted[i].first) << "\n";
+        }
+    };
+    auto same = [](const std::string& name) { return name; };
+    out << "Lua profile: " << samples << " samples\n";
+    print("Functions (self)", SortedByTime(function_ns), same);
+    print("Chunks (self)", SortedByTime(chunk_ns), same);
+    print("Entities", SortedByTime(entity_ns), EntityLabel);
+}
+
+void LuaProfiler::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table profiler_table = lua.create_named_table("LuaProfiler");
+    // LuaProfiler.start([period_us [, instruction_interval]])
+    profiler_table["start"] = [](sol::optional<double> period_us, sol::optional<int> instruction_interval) {
+        LuaProfiler::GetInstance().Start(period_us.value_or(1000.0), instruction_interval.value_or(100));
+    };
+    profiler_table["stop"] = []() {
+        LuaProfiler::GetInstance().Stop();
+    };
+    profiler_table["is_running"] = []() {
+        return LuaProfiler::GetInstance().IsRunning();
+    };
+    profiler_table["clear"] = []() {
+        LuaProfiler::GetInstance().Clear();
+    };
+    profiler_table["dump"] = [](const std::string& path) {
+        return LuaProfiler::GetInstance().WriteFolded(path);
+    };
+    profiler_table["print_report"] = [](sol::optional<int> limit) {
+        LuaProfiler::GetInstance().PrintReport(std::cout, static_cast<size_t>(std::max(limit.value_or(15), 1)));
+    };
+    // Self time per function in milliseconds, most expensive first
+    profiler_table["get_functions"] = []() {
+        sol::state& lua = LuaManager::GetInstance();
+        auto sorted = SortedByTime(LuaProfiler::GetInstance().function_ns);
+        sol::table result = lua.create_table(static_cast<int>(sorted.size()), 0);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            result[i + 1] = lua.create_table_with("name", sorted[i].first, "self_ms", sorted[i].second / 1000000.0);
+        }
+        return result;
+    };
+}
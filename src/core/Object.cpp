@@ -1,47 +1,150 @@
 #include <Object.hpp>
+#include <Logger.hpp>
+#include <TransformSystem.hpp>
+#include <ScriptCache.hpp>
+#include <Profiler.hpp>
+#include <LuaProfiler.hpp>
+#include <InputSystem.hpp>
+#include <algorithm>
 
-Object::Object() : entity(RegistryManager::GetInstance().create()) {
-    std::cout << "Object created with entity ID: " << static_cast<int>(entity) << "\n";
+namespace {
 
-    sol::state& lua = LuaManager::GetInstance();
-    environment = sol::environment(lua, sol::create, lua.globals());
-    environment["instance"] = this;
-    environment["self"] = environment;
-    environment["entity"] = entity;
-    environment["parent"] = [this]() -> sol::object {
-        auto parent = RegistryManager::GetInstance().get<std::shared_ptr<Object>>(parent_entity);
+// Emptied children/components vectors, kept so new Objects reuse their capacity.
+// Never destroyed: Objects can outlive it during static teardown.
+std::vector<std::vector<entt::entity>>& GetSpareBuffers() {
+    static auto* buffers = new std::vector<std::vector<entt::entity>>();
+    return *buffers;
+}
+
+void TakeBuffer(std::vector<entt::entity>& buffer) {
+    auto& spare = GetSpareBuffers();
+    if (!spare.empty()) {
+        buffer = std::move(spare.back());
+        spare.pop_back();
+    }
+}
+
+void RecycleBuffer(std::vector<entt::entity>& buffer) {
+    if (buffer.capacity() > 0) {
+        buffer.clear();
+        GetSpareBuffers().push_back(std::move(buffer));
+    }
+}
+
+} // namespace
+
+Object::Object() : Object(ObjectType::Object) {}
+
+Object::Object(ObjectType type) : entity(RegistryManager::GetInstance().create()) {
+    Logger::Debug(LogCategory::Lifecycle, "Object created with entity ID: ", static_cast<int>(entity));
+
+    environment_slot = &EnvironmentPool::Acquire(type, environment);
+    environment_slot->instance = this;
+    // Raw, so the engine's own fields bypass __newindex
+    environment.raw_set("instance", static_cast<void*>(this), "self", environment, "entity", entity);
+    if (environment_slot->needs_binding) {
+        BindMethods();
+    }
+
+    TakeBuffer(children);
+    TakeBuffer(components);
+}
+
+void Object::BindMethods() {
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["parent"] = [slot]() -> sol::object {
+        auto parent = RegistryManager::GetInstance().get<std::shared_ptr<Object>>(FromSlot(*slot).parent_entity);
         if (parent) {
             return parent->GetEnvironment();
         }
         return sol::lua_nil;
     };
-    environment["add_child"] = [this](sol::environment child) {
+    methods["add_child"] = [slot](sol::environment child) {
         if (child["entity"].valid()) {
             sol::optional<int> entity_id = child["entity"];
             entt::entity child_entity = static_cast<entt::entity>(entity_id.value());
-            AddChild(child_entity);
+            FromSlot(*slot).AddChild(child_entity);
         } else {
             throw std::runtime_error("Entity not found in userdata environment.");
         }
     };
-    environment["add_component"] = [this](sol::environment component) {
+    methods["add_component"] = [slot](sol::environment component) {
         if (component["entity"].valid()) {
             sol::optional<int> entity_id = component["entity"];
             entt::entity component_entity = static_cast<entt::entity>(entity_id.value());
-            AddComponent(component_entity);
+            FromSlot(*slot).AddComponent(component_entity);
         } else {
             throw std::runtime_error("Entity not found in userdata environment.");
         }
     };
-    environment["set_script"] = [this](const std::string& file_path) {
-        SetScript(file_path);
+    methods["set_script"] = [slot](const std::string& file_path) {
+        FromSlot(*slot).SetScript(file_path);
+    };
+    methods["queue_free"] = [slot]() {
+        FromSlot(*slot).QueueFree();
     };
+
+    // Assignments to lifecycle callbacks land in the slot's callbacks table
+    slot->metatable[sol::meta_function::new_index] = &Object::OnEnvironmentAssign;
+}
+
+void Object::ResolveLifecycleCallbacks() {
+    sol::object process = environment["process"];
+    sol::object process_input = environment["process_input"];
+    sol::object process_action = environment["process_action"];
+    process_callback = process.get_type() == sol::type::function ? sol::protected_function(process) : sol::protected_function();
+    process_input_callback = process_input.get_type() == sol::type::function ? sol::protected_function(process_input) : sol::protected_function();
+    process_action_callback = process_action.get_type() == sol::type::function ? sol::protected_function(process_action) : sol::protected_function();
+    UpdateInputSubscription();
+}
+
+void Object::UpdateInputSubscription() {
+    if (HandlesInput()) {
+        InputSystem::GetInstance().Subscribe(entity);
+    }
+}
+
+void Object::OnEnvironmentAssign(sol::table env, sol::object key, sol::object value) {
+    // Shared by every Object environment, so find the owner through the instance field
+    sol::object instance = env.raw_get<sol::object>("instance");
+    if (key.get_type() == sol::type::string && instance.get_type() == sol::type::lightuserdata) {
+        Object& object = *static_cast<Object*>(instance.as<void*>());
+        const std::string name = key.as<std::string>();
+        auto as_callback = [&value]() {
+            return value.get_type() == sol::type::function ? sol::protected_function(value) : sol::protected_function();
+        };
+        if (name == "process") {
+            object.environment_slot->callbacks.raw_set(key, value);
+            object.process_callback = as_callback();
+            return;
+        }
+        if (name == "process_input") {
+            object.environment_slot->callbacks.raw_set(key, value);
+            object.process_input_callback = as_callback();
+            object.UpdateInputSubscription();
+            return;
+        }
+        if (name == "process_action") {
+            object.environment_slot->callbacks.raw_set(key, value);
+            object.process_action_callback = as_callback();
+            object.UpdateInputSubscription();
+            return;
+        }
+    }
+    env.raw_set(key, value);
+}
+
+Object::~Object() {
+    EnvironmentPool::Release(*environment_slot, environment);
+    RecycleBuffer(children);
+    RecycleBuffer(components);
 }
 
 std::shared_ptr<Object> Object::Create() {
-    auto obj_instance = std::make_shared<Object>();
+    auto obj_instance = MakePooled<Object>();
     RegistryManager::GetInstance().emplace<std::shared_ptr<Object>>(obj_instance->entity, obj_instance);
-    RegistryManager::GetInstance().emplace<std::string>(obj_instance->entity, "Object");
+    RegistryManager::GetInstance().emplace<ObjectType>(obj_instance->entity, ObjectType::Object);
     return obj_instance;
 }
 
@@ -58,35 +161,47 @@ void Object::Register() {
 
 void Object::SetScript(const std::string& file_path) {
     try {
-        LuaManager::GetInstance().script_file(file_path, environment);
+        LuaProfiler::Scope profile_scope(entity);
+        ScriptCache::GetInstance().Run(file_path, environment);
     } catch (const sol::error& err) {
         throw std::runtime_error("Failed to load Lua script file: " + std::string(err.what()));
     }
+    script_path = file_path;
+    ResolveLifecycleCallbacks();
+}
+
+void Object::ReloadScript() {
+    if (script_path.empty()) {
+        return;
+    }
+    try {
+        LuaProfiler::Scope profile_scope(entity);
+        ScriptCache::GetInstance().Reload(script_path, environment);
+    } catch (const sol::error& err) {
+        throw std::runtime_error("Failed to reload Lua script file: " + std::string(err.what()));
+    }
+    ResolveLifecycleCallbacks();
 }
 
 void Object::Process(float delta) {
+    ProfileZone zone("Object::Process");
     for (const entt::entity child_entity : children) {
         auto& child = RegistryManager::GetInstance().get<std::shared_ptr<Object>>(child_entity);
         child->Process(delta);
     }
 
-    if (environment["process"].valid()) {
-        try {
-            environment["process"](delta);
-        } catch (const sol::error& e) {
-            std::cerr << "Error processing in Lua: " << e.what() << "\n";
+    if (process_callback.valid()) {
+        LuaProfiler::Scope profile_scope(entity);
+        sol::protected_function_result result = process_callback(delta);
+        if (!result.valid()) {
+            sol::error e = result;
+            Logger::Error(LogCategory::Script, "Error processing in Lua: ", e.what());
         }
     }
 }
 
 void Object::ProcessInput(const SDL_Event& event) {
-    if (environment["process_input"].valid()) {
-        try {
-            environment["process_input"](event);
-        } catch (const sol::error& e) {
-            std::cerr << "Error processing input in Lua: " << e.what() << "\n";
-        }
-    }
+    HandleInput(event);
 
     for (const entt::entity child_entity : children) {
         auto& child = RegistryManager::GetInstance().get<std::shared_ptr<Object>>(child_entity);
@@ -94,48 +209,133 @@ void Object::ProcessInput(const SDL_Event& event) {
     }
 }
 
+void Object::HandleInput(const SDL_Event& event) {
+    if (process_input_callback.valid()) {
+        LuaProfiler::Scope profile_scope(entity);
+        sol::protected_function_result result = process_input_callback(event);
+        if (!result.valid()) {
+            sol::error e = result;
+            Logger::Error(LogCategory::Script, "Error processing input in Lua: ", e.what());
+        }
+    }
+}
+
+void Object::HandleAction(int action_id, bool pressed) {
+    if (process_action_callback.valid()) {
+        LuaProfiler::Scope profile_scope(entity);
+        sol::protected_function_result result = process_action_callback(action_id, pressed);
+        if (!result.valid()) {
+            sol::error e = result;
+            Logger::Error(LogCategory::Script, "Error processing action in Lua: ", e.what());
+        }
+    }
+}
+
+bool Object::HandlesInput() const {
+    return process_input_callback.valid() || process_action_callback.valid();
+}
+
 void Object::AddChild(entt::entity child_entity) {
-    std::cout << "Adding child to Object with entity ID: " << static_cast<int>(entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "Adding child to Object with entity ID: ", static_cast<int>(entity));
     if (!RegistryManager::GetInstance().valid(child_entity)) {
-        std::cerr << "Invalid child entity ID: " << static_cast<int>(child_entity) << "\n";
+        Logger::Error(LogCategory::Lifecycle, "Invalid child entity ID: ", static_cast<int>(child_entity));
         return;
     }
 
     auto& child = RegistryManager::GetInstance().get<std::shared_ptr<Object>>(child_entity);
-    std::cout << "Child entity ID: " << static_cast<int>(child->entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "Child entity ID: ", static_cast<int>(child->entity));
     if (!child) {
-        std::cerr << "Failed to retrieve the instance for entity ID: " << static_cast<int>(child_entity) << "\n";
+        Logger::Error(LogCategory::Lifecycle, "Failed to retrieve the instance for entity ID: ", static_cast<int>(child_entity));
         return;
     }
     child->parent_entity = entity;
+    TransformSystem::GetInstance().SetParent(child_entity, entity);
     children.push_back(child_entity);
-    std::cout << "Child added to Object with entity ID: " << static_cast<int>(child_entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "Child added to Object with entity ID: ", static_cast<int>(child_entity));
 }
 
 void Object::AddComponent(entt::entity component_entity) {
     if (!RegistryManager::GetInstance().valid(component_entity)) {
-        std::cerr << "Invalid component entity ID: " << static_cast<int>(component_entity) << "\n";
+        Logger::Error(LogCategory::Lifecycle, "Invalid component entity ID: ", static_cast<int>(component_entity));
         return;
     }
 
     auto& component = RegistryManager::GetInstance().get<std::shared_ptr<Component>>(component_entity);
-    std::cout << "Component entity ID: " << static_cast<int>(component->entity) << "\n";
+    Logger::Debug(LogCategory::Lifecycle, "Component entity ID: ", static_cast<int>(component->entity));
     if (!component) {
-        std::cerr << "Failed to retrieve the instance for entity ID: " << static_cast<int>(component_entity) << "\n";
+        Logger::Error(LogCategory::Lifecycle, "Failed to retrieve the instance for entity ID: ", static_cast<int>(component_entity));
         return;
     }
 
     for (const auto& existing_entity : components) {
         auto& existing_component = RegistryManager::GetInstance().get<std::shared_ptr<Component>>(existing_entity);
         if (typeid(*component) == typeid(*existing_component)) {
-            std::cerr << "A component of type " << typeid(*component).name() 
-                      << " already exists for this object.\n";
+            Logger::Error(LogCategory::Lifecycle, "A component of type ", typeid(*component).name(),
+                          " already exists for this object.");
             return;
         }
     }
 
     component->Emplace(entity);
-    std::cout << "Component added to Object with entity ID: " << static_cast<int>(component_entity) << "\n";
+    components.push_back(component_entity);
+    Logger::Debug(LogCategory::Lifecycle, "Component added to Object with entity ID: ", static_cast<int>(component_entity));
+}
+
+void Object::Destroy() {
+    auto& registry = RegistryManager::GetInstance();
+    if (!registry.valid(entity)) {
+        return;
+    }
+
+    // Keep this instance alive until teardown finishes
+    auto self = shared_from_this();
+
+    for (const entt::entity child_entity : std::vector<entt::entity>(children)) {
+        if (registry.valid(child_entity)) {
+            registry.get<std::shared_ptr<Object>>(child_entity)->Destroy();
+        }
+    }
+    children.clear();
+
+    for (const entt::entity component_entity : components) {
+        if (registry.valid(component_entity)) {
+            registry.destroy(component_entity);
+        }
+    }
+    components.clear();
+
+    // Detach from the parent
+    if (registry.valid(parent_entity)) {
+        if (auto* parent = registry.try_get<std::shared_ptr<Object>>(parent_entity)) {
+            auto& siblings = (*parent)->children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), entity), siblings.end());
+        }
+    }
+
+    registry.destroy(entity);
+}
+
+namespace {
+std::vector<entt::entity>& GetDestroyQueue() {
+    static std::vector<entt::entity> queue;
+    return queue;
+}
+}
+
+void Object::QueueFree() {
+    GetDestroyQueue().push_back(entity);
+}
+
+void Object::DestroyQueued() {
+    auto& registry = RegistryManager::GetInstance();
+    auto& queue = GetDestroyQueue();
+    for (size_t i = 0; i < queue.size(); ++i) {
+        // Entries may already be gone if an ancestor was destroyed first
+        if (registry.valid(queue[i])) {
+            registry.get<std::shared_ptr<Object>>(queue[i])->Destroy();
+        }
+    }
+    queue.clear();
 }
 
 sol::environment& Object::GetEnvironment() {
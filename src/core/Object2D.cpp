@@ -1,20 +1,41 @@
 #include <Object2D.hpp>
 
-Object2D::Object2D() : Object(), position(0.0f, 0.0f), global_position(0.0f, 0.0f) {
-    sol::state& lua = LuaManager::GetInstance();
-    environment["position"] = sol::as_table(std::ref(position));
-    environment["global_position"] = sol::as_table(std::ref(global_position));
-    environment["set_position"] = [this](float x, float y) {
-        SetPosition(x, y);
+Object2D::Object2D() : Object(ObjectType::Object2D) {
+    // Touch the system first so it observes the transform being created
+    TransformSystem::GetInstance();
+    transform = &RegistryManager::GetInstance().emplace<Transform2D>(entity);
+
+    environment.raw_set("position", sol::as_table(std::ref(transform->position)),
+                        "global_position", sol::as_table(std::ref(transform->global_position)));
+    if (!environment_slot->needs_binding) {
+        return;
+    }
+
+    EnvironmentSlot* slot = environment_slot;
+    sol::table& methods = slot->methods;
+    methods["set_position"] = [slot](float x, float y) {
+        FromSlot<Object2D>(*slot).SetPosition(x, y);
+    };
+    methods["get_position"] = [slot]() {
+        return FromSlot<Object2D>(*slot).GetPosition();
+    };
+    methods["set_global_position"] = [slot](float x, float y) {
+        FromSlot<Object2D>(*slot).SetGlobalPosition(x, y);
+    };
+    methods["get_global_position"] = [slot]() {
+        return FromSlot<Object2D>(*slot).GetGlobalPosition();
+    };
+    methods["set_rotation"] = [slot](float degrees) {
+        FromSlot<Object2D>(*slot).SetRotation(degrees);
     };
-    environment["get_position"] = [this]() {
-        return GetPosition();
+    methods["get_rotation"] = [slot]() {
+        return FromSlot<Object2D>(*slot).GetRotation();
     };
-    environment["set_global_position"] = [this](float x, float y) {
-        SetGlobalPosition(x, y);
+    methods["set_scale"] = [slot](float x, float y) {
+        FromSlot<Object2D>(*slot).SetScale(x, y);
     };
-    environment["get_global_position"] = [this]() {
-        return GetGlobalPosition();
+    methods["get_scale"] = [slot]() {
+        return FromSlot<Object2D>(*slot).GetScale();
     };
 }
 
@@ -30,54 +51,51 @@ void Object2D::Register() {
     );
 }
 
-void Object2D::Process(float delta) {
-    Object::Process(delta);
-
-    if (position_dirty) {
-        UpdateGlobalPosition();
-        position_dirty = false;
-    }
-    if (global_position_dirty) {
-        UpdateLocalPosition();
-        global_position_dirty = false;
-    }
-}
-
 void Object2D::SetPosition(float x, float y) {
-    if (this->position.x != x || this->position.y != y) {
-        this->position.x = x;
-        this->position.y = y;
-        this->position_dirty = true;
+    if (transform->position.x != x || transform->position.y != y) {
+        TransformSystem::GetInstance().SetPosition(entity, Vector2(x, y));
     }
 }
 
 Vector2 Object2D::GetPosition() {
-    if (position_dirty) {
-        UpdateLocalPosition();
-        position_dirty = false;
-    }
-    return position;
+    return transform->position;
 }
 
 void Object2D::SetGlobalPosition(float x, float y) {
-    if (this->global_position.x != x || this->global_position.y != y) {
-        this->global_position.x = x;
-        this->global_position.y = y;
-        global_position_dirty = true;
+    if (transform->global_position.x != x || transform->global_position.y != y) {
+        TransformSystem::GetInstance().SetGlobalPosition(entity, Vector2(x, y));
     }
 }
 
 Vector2 Object2D::GetGlobalPosition() {
-    if (global_position_dirty) {
-        UpdateGlobalPosition();
-        global_position_dirty = false;
-    }
-    return global_position;
+    return transform->global_position;
+}
+
+Vector2 Object2D::GetInterpolatedPosition(float alpha) {
+    return Vector2::Lerp(transform->previous_global_position, transform->global_position, alpha);
+}
+
+void Object2D::SetRotation(float degrees) {
+    transform->rotation = degrees;
+    transform->dirty = true;
+}
+
+float Object2D::GetRotation() const {
+    return transform->rotation;
+}
+
+void Object2D::SetScale(float x, float y) {
+    transform->scale = Vector2(x, y);
+    transform->dirty = true;
+}
+
+Vector2 Object2D::GetScale() const {
+    return transform->scale;
 }
 
 void Object2D::SetParent(entt::entity parent_entity_ref) {
     parent_entity = parent_entity_ref;
-    position_dirty = true; // Parent affects global position
+    TransformSystem::GetInstance().SetParent(entity, parent_entity_ref); // Parent affects global position
 }
 
 entt::entity Object2D::GetParent() const {
@@ -85,50 +103,9 @@ entt::entity Object2D::GetParent() const {
 }
 
 std::shared_ptr<Object2D> Object2D::Create() {
-    auto obj_instance = std::make_shared<Object2D>();
+    auto obj_instance = MakePooled<Object2D>();
     RegistryManager::GetInstance().emplace<std::shared_ptr<Object>>(obj_instance->entity, obj_instance);
-    RegistryManager::GetInstance().emplace<std::string>(obj_instance->entity, "Object2D");
+    RegistryManager::GetInstance().emplace<ObjectType>(obj_instance->entity, ObjectType::Object2D);
+    RegistryManager::GetInstance().emplace<Object2DTag>(obj_instance->entity);
     return obj_instance;
 }
-
-void Object2D::UpdateGlobalPosition() {
-    auto& registry = RegistryManager::GetInstance();
-    if (registry.valid(parent_entity)) { // Ensure the parent entity exists
-        auto& parent = registry.get<std::shared_ptr<Object>>(parent_entity);
-        if (parent) {
-            auto parent2D = std::dynamic_pointer_cast<Object2D>(parent);
-            if (parent2D) {
-                auto parent_global = parent2D->GetGlobalPosition();
-                this->global_position.x = this->position.x + parent_global.x;
-                this->global_position.y = this->position.y + parent_global.y;
-            } else {
-                global_position = this->position; // Parent isn't 2D
-            }
-        } else {
-            this->global_position = this->position; // No parent
-        }
-    } else {
-        this->global_position = this->position; // No parent
-    }
-}
-
-void Object2D::UpdateLocalPosition() {
-    auto& registry = RegistryManager::GetInstance();
-    if (registry.valid(parent_entity)) { // Ensure the parent entity exists
-        auto& parent = registry.get<std::shared_ptr<Object>>(parent_entity);
-        if (parent) {
-            auto parent2D = std::dynamic_pointer_cast<Object2D>(parent);
-            if (parent2D) {
-                auto parent_global = parent2D->GetGlobalPosition();
-                this->position.x = this->global_position.x - parent_global.x;
-                this->position.y = this->global_position.y - parent_global.y;
-            } else {
-                this->position = this->global_position; // Parent isn't 2D
-            }
-        } else {
-            this->position = this->global_position; // No parent
-        }
-    } else {
-        this->position = this->global_position; // No parent
-    }
-}
@@ -0,0 +1,186 @@
+#include <PhysicsSystem.hpp>
+#include <SpatialHash2D.hpp>
+#include <TransformSystem.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Gap kept between touching colliders so the next sweep starts outside
+constexpr float skin = 0.01f;
+
+// Time of impact in [0, 1] of a point moving by motion into the box [min, max]
+bool SweepPoint(const Vector2& origin, const Vector2& motion, const Vector2& min, const Vector2& max, float& time, Vector2& normal) {
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    const float origins[2] = {origin.x, origin.y};
+    const float motions[2] = {motion.x, motion.y};
+    const float mins[2] = {min.x, min.y};
+    const float maxs[2] = {max.x, max.y};
+    float entry[2], exit[2];
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (motions[axis] == 0.0f) {
+            if (origins[axis] <= mins[axis] || origins[axis] >= maxs[axis]) {
+                return false;
+            }
+            entry[axis] = -infinity;
+            exit[axis] = infinity;
+            continue;
+        }
+        float t1 = (mins[axis] - origins[axis]) / motions[axis];
+        float t2 = (maxs[axis] - origins[axis]) / motions[axis];
+        entry[axis] = std::min(t1, t2);
+        exit[axis] = std::max(t1, t2);
+    }
+
+    float t_entry = std::max(entry[0], entry[1]);
+    float t_exit = std::min(exit[0], exit[1]);
+    // Starting inside (t_entry < 0) is ignored so overlapping bodies can separate
+    if (t_entry > t_exit || t_entry < 0.0f || t_entry > 1.0f) {
+        return false;
+    }
+
+    time = t_entry;
+    if (entry[0] > entry[1]) {
+        normal = Vector2(motion.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+    } else {
+        normal = Vector2(0.0f, motion.y > 0.0f ? -1.0f : 1.0f);
+    }
+    return true;
+}
+
+} // namespace
+
+PhysicsSystem& PhysicsSystem::GetInstance() {
+    static PhysicsSystem instance;
+    return instance;
+}
+
+PhysicsSettings& PhysicsSystem::GetSettings() {
+    return settings;
+}
+
+const PhysicsStats& PhysicsSystem::GetStats() const {
+    return stats;
+}
+
+void PhysicsSystem::Step(float step) {
+    auto& registry = RegistryManager::GetInstance();
+    auto& colliders = registry.storage<Collider2D>();
+    TransformSystem& transforms = TransformSystem::GetInstance();
+    stats = PhysicsStats();
+
+    const Vector2 gravity = settings.gravity * settings.gravity_scale;
+    const float drag = settings.drag * settings.drag_scale;
+
+    for (auto [entity, body, transform] : registry.view<RigidBody2D, Transform2D>().each()) {
+        body.colliding = false;
+        body.collision_normal = Vector2();
+        if (body.mass <= 0.0f) {
+            continue;
+        }
+        ++stats.bodies;
+
+        if (body.use_gravity) {
+            body.velocity = body.velocity + gravity * (body.gravity_scale * step);
+        }
+        float damping = drag * body.drag * step;
+        if (damping > 0.0f) {
+            body.velocity = body.velocity * std::max(0.0f, 1.0f - damping);
+        }
+
+        Vector2 motion = body.velocity * step;
+        if (motion.x == 0.0f && motion.y == 0.0f) {
+            continue;
+        }
+
+        Vector2 position = transform.global_position;
+        if (colliders.contains(entity) && colliders.get(entity).enabled) {
+            position = Sweep(entity, colliders.get(entity), body, position, motion);
+        } else {
+            position = position + motion;
+        }
+        transforms.SetGlobalPosition(entity, position);
+    }
+}
+
+Vector2 PhysicsSystem::Sweep(entt::entity entity, const Collider2D& collider, RigidBody2D& body, Vector2 position, Vector2 motion) {
+    auto& registry = RegistryManager::GetInstance();
+    auto& colliders = registry.storage<Collider2D>();
+    auto& transform_storage = registry.storage<Transform2D>();
+    SpatialHash2D& grid = SpatialHash2D::GetInstance();
+    const Vector2 half = collider.GetHalfExtents();
+
+    for (int iteration = 0; iteration < settings.max_iterations; ++iteration) {
+        const Vector2 center = position + collider.offset;
+
+        // Broadphase over the box swept by this move
+        candidates.clear();
+        grid.QueryAABB(Vector2::Min(center, center + motion) - half, Vector2::Max(center, center + motion) + half, candidates);
+
+        float best_time = 1.0f;
+        Vector2 best_normal;
+        for (entt::entity other : candidates) {
+            if (other == entity || !colliders.contains(other) || !transform_storage.contains(other)) continue;
+            const Collider2D& other_collider = colliders.get(other);
+            if (!other_collider.enabled) continue;
+
+            // Sweep the center against the other box grown by our half extents
+            const Vector2 other_center = transform_storage.get(other).global_position + other_collider.offset;
+            const Vector2 extents = other_collider.GetHalfExtents() + half;
+            float time = 0.0f;
+            Vector2 normal;
+            if (SweepPoint(center, motion, other_center - extents, other_center + extents, time, normal) && time < best_time) {
+                best_time = time;
+                best_normal = normal;
+            }
+        }
+
+        if (best_time >= 1.0f) {
+            return position + motion;
+        }
+
+        ++stats.contacts;
+        body.colliding = true;
+        body.collision_normal = best_normal;
+
+        // Stop just short of the contact, then slide the rest of the motion along the surface
+        float length = Vector2::Magnitude(motion);
+        float time = std::max(0.0f, best_time - skin / length);
+        position = position + motion * time;
+
+        Vector2 remaining = motion * (1.0f - best_time);
+        remaining = remaining - best_normal * Vector2::Dot(remaining, best_normal);
+        float into_surface = Vector2::Dot(body.velocity, best_normal);
+        if (into_surface < 0.0f) {
+            body.velocity = body.velocity - best_normal * into_surface;
+        }
+
+        motion = remaining;
+        if (motion.x == 0.0f && motion.y == 0.0f) {
+            break;
+        }
+    }
+    return position;
+}
+
+void PhysicsSystem::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table tree = lua["tree"].get_or_create<sol::table>();
+    tree["set_global_gravity"] = [](float x, float y) {
+        PhysicsSystem::GetInstance().GetSettings().gravity = Vector2(x, y);
+    };
+    tree["get_global_gravity"] = []() {
+        return PhysicsSystem::GetInstance().GetSettings().gravity;
+    };
+    tree["set_global_drag"] = [](float drag) {
+        PhysicsSystem::GetInstance().GetSettings().drag = std::max(0.0f, drag);
+    };
+    tree["set_gravity_scale"] = [](float scale) {
+        PhysicsSystem::GetInstance().GetSettings().gravity_scale = scale;
+    };
+    tree["set_drag_scale"] = [](float scale) {
+        PhysicsSystem::GetInstance().GetSettings().drag_scale = std::max(0.0f, scale);
+    };
+}
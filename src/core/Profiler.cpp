@@ -0,0 +1,185 @@
+#include <Profiler.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// Set on a thread's first recorded zone
+thread_local void* thread_buffer = nullptr;
+thread_local std::string thread_name;
+
+void WriteJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                out << escaped;
+            } else {
+                out << *c;
+            }
+        }
+    }
+    out << '"';
+}
+
+void WriteMicroseconds(std::ostream& out, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out << text;
+}
+
+} // namespace
+
+Profiler& Profiler::GetInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : epoch(std::chrono::steady_clock::now()) {}
+
+void Profiler::SetEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    thread_name = name;
+    if (thread_buffer) {
+        Profiler& profiler = GetInstance();
+        std::lock_guard<std::mutex> lock(profiler.buffers_mutex);
+        static_cast<ThreadBuffer*>(thread_buffer)->name = name;
+    }
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+    if (!thread_buffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffer->thread = static_cast<uint32_t>(buffers.size());
+        buffer->name = thread_name.empty() ? "thread " + std::to_string(buffer->thread) : thread_name;
+        thread_buffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer*>(thread_buffer);
+}
+
+void Profiler::Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    if (!IsEnabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = GetThreadBuffer();
+    const uint64_t index = buffer.head.load(std::memory_order_relaxed);
+
+    // Announce the overwrite first so a concurrent Collect can tell which slots it may have torn
+    buffer.writing.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = buffer.slots[index % events_per_thread];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start_ns.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count()),
+                        std::memory_order_relaxed);
+    slot.end_ns.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - epoch).count()),
+                      std::memory_order_relaxed);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ProfileEvent> Profiler::Collect() const {
+    std::vector<ProfileEvent> events;
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (const auto& buffer : buffers) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t first = std::max(buffer->tail.load(std::memory_order_relaxed),
+                                  head > events_per_thread ? head - events_per_thread : 0);
+        const size_t copied_from = events.size();
+        for (uint64_t i = first; i < head; ++i) {
+            const Slot& slot = buffer->slots[i % events_per_thread];
+            events.push_back({slot.name.load(std::memory_order_relaxed), buffer->thread,
+                              slot.start_ns.load(std::memory_order_relaxed), slot.end_ns.load(std::memory_order_relaxed)});
+        }
+
+        // Drop events the owning thread overwrote while we were copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writing = buffer->writing.load(std::memory_order_relaxed);
+        const uint64_t valid = writing > events_per_thread ? writing - events_per_thread : 0;
+        if (valid > first) {
+            const size_t torn = static_cast<size_t>(std::min(valid, head) - first);
+            events.erase(events.begin() + copied_from, events.begin() + copied_from + torn);
+        }
+    }
+    return events;
+}
+
+void Profiler::Clear() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (const auto& buffer : buffers) {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Profiler::WriteChromeTrace(std::ostream& out) const {
+    std::vector<ProfileEvent> events = Collect();
+    std::sort(events.begin(), events.end(), [](const ProfileEvent& lhs, const ProfileEvent& rhs) {
+        return lhs.start_ns < rhs.start_ns;
+    });
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for (const auto& buffer : buffers) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread
+                << ",\"args\":{\"name\":";
+            WriteJsonString(out, buffer->name.c_str());
+            out << "}}";
+            first = false;
+        }
+    }
+    for (const ProfileEvent& event : events) {
+        out << (first ? "" : ",\n") << "{\"name\":";
+        WriteJsonString(out, event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":";
+        WriteMicroseconds(out, event.start_ns);
+        out << ",\"dur\":";
+        WriteMicroseconds(out, event.end_ns - event.start_ns);
+        out << "}";
+        first = false;
+    }
+    out << "\n]}\n";
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write profile: " << path << "\n";
+        return false;
+    }
+    WriteChromeTrace(file);
+    std::cout << "Wrote profile " << path << "\n";
+    return static_cast<bool>(file);
+}
+
+void Profiler::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table profiler_table = lua.create_named_table("Profiler");
+    profiler_table["set_enabled"] = [](bool enabled) {
+        Profiler::GetInstance().SetEnabled(enabled);
+    };
+    profiler_table["is_enabled"] = []() {
+        return Profiler::GetInstance().IsEnabled();
+    };
+    profiler_table["clear"] = []() {
+        Profiler::GetInstance().Clear();
+    };
+    // Profiler.export("profile.json"): open in about:tracing or ui.perfetto.dev
+    profiler_table["export"] = [](const std::string& path) {
+        return Profiler::GetInstance().WriteChromeTrace(path);
+    };
+}
@@ -0,0 +1,246 @@
+#include <ScriptCache.hpp>
+#include <AssetArchive.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+// FNV-1a over the source, seeded with the Lua version so stale bytecode is never matched
+uint64_t HashSource(const std::string& source) {
+    uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(LUA_VERSION_NUM);
+    for (unsigned char c : source) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool ReadFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+int WriteBytecode(lua_State*, const void* data, size_t size, void* user_data) {
+    static_cast<std::string*>(user_data)->append(static_cast<const char*>(data), size);
+    return 0;
+}
+
+// Pops the error message left by a failed load
+sol::error PopLoadError(lua_State* L) {
+    const char* message = lua_tostring(L, -1);
+    sol::error error(message ? message : "unknown error");
+    lua_pop(L, 1);
+    return error;
+}
+
+} // namespace
+
+ScriptCache& ScriptCache::GetInstance() {
+    static ScriptCache instance;
+    return instance;
+}
+
+void ScriptCache::Run(const std::string& path, sol::environment& env) {
+    const Entry* entry = nullptr;
+    auto it = entries.find(NormalizePath(path));
+    if (it != entries.end()) {
+        entry = &it->second;
+        ++stats.hits;
+    } else {
+        entry = &Compile(path);
+    }
+
+    // Undumping gives a fresh closure, so setting _ENV never leaks into other instances
+    lua_State* L = env.lua_state();
+    const std::string chunk_name = "@" + path;
+    if (luaL_loadbufferx(L, entry->bytecode.data(), entry->bytecode.size(), chunk_name.c_str(), "b") != LUA_OK) {
+        throw PopLoadError(L);
+    }
+    sol::protected_function chunk(L, -1);
+    lua_pop(L, 1);
+
+    sol::set_environment(env, chunk);
+    ++stats.runs;
+    sol::protected_function_result result = chunk();
+    if (!result.valid()) {
+        sol::error err = result;
+        throw err;
+    }
+}
+
+void ScriptCache::Reload(const std::string& path, sol::environment& env) {
+    // Snapshot what the script left behind; running it again reassigns its globals
+    std::vector<std::pair<sol::object, sol::object>> previous;
+    env.for_each([&](const sol::object& key, const sol::object& value) {
+        previous.emplace_back(key, value);
+    });
+
+    try {
+        Run(path, env);
+    } catch (const sol::error&) {
+        // Put back whatever the failed run had already overwritten
+        for (auto& [key, old_value] : previous) {
+            env.raw_set(key, old_value);
+        }
+        throw;
+    }
+    ++stats.reloads;
+
+    std::unordered_set<const void*> visited;
+    for (auto& [key, old_value] : previous) {
+        sol::object new_value = env.raw_get<sol::object>(key);
+        if (new_value.get_type() == sol::type::function) {
+            continue;
+        }
+        if (old_value.get_type() == sol::type::table && new_value.get_type() == sol::type::table
+            && old_value.pointer() != new_value.pointer()) {
+            // Others may hold the old table (e.g. a state machine's states), so update it in place
+            MergeState(old_value.as<sol::table>(), new_value.as<sol::table>(), visited);
+        }
+        env.raw_set(key, old_value);
+    }
+}
+
+void ScriptCache::MergeState(sol::table current, sol::table fresh, std::unordered_set<const void*>& visited) {
+    if (!visited.insert(current.pointer()).second) {
+        return;
+    }
+    fresh.for_each([&](const sol::object& key, const sol::object& new_value) {
+        sol::object old_value = current.raw_get<sol::object>(key);
+        if (new_value.get_type() == sol::type::function || old_value.get_type() == sol::type::lua_nil) {
+            current.raw_set(key, new_value);
+        } else if (old_value.get_type() == sol::type::table && new_value.get_type() == sol::type::table
+                   && old_value.pointer() != new_value.pointer()) {
+            MergeState(old_value.as<sol::table>(), new_value.as<sol::table>(), visited);
+        }
+    });
+}
+
+bool ScriptCache::Recompile(const std::string& path) {
+    try {
+        Compile(path);
+        return true;
+    } catch (const sol::error& e) {
+        std::cerr << "Failed to recompile " << path << ": " << e.what() << "\n";
+        return false;
+    }
+}
+
+const ScriptCache::Entry& ScriptCache::Compile(const std::string& path) {
+    // Packed archives take precedence over loose files
+    std::string source;
+    std::string_view archived;
+    if (AssetArchive::GetInstance().Read(path, archived)) {
+        source.assign(archived);
+    } else if (!ReadFile(path, source)) {
+        throw sol::error("cannot open " + path);
+    }
+
+    lua_State* L = LuaManager::GetInstance().lua_state();
+    Entry entry;
+    entry.source_hash = HashSource(source);
+
+    // Reuse bytecode persisted by an earlier run if the source is unchanged
+    std::filesystem::path cache_file;
+    if (!disk_directory.empty()) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(entry.source_hash));
+        cache_file = std::filesystem::path(disk_directory) / name;
+        if (ReadFile(cache_file.string(), entry.bytecode)) {
+            if (luaL_loadbufferx(L, entry.bytecode.data(), entry.bytecode.size(), path.c_str(), "b") == LUA_OK) {
+                lua_pop(L, 1);
+                ++stats.disk_hits;
+                return entries[NormalizePath(path)] = std::move(entry);
+            }
+            lua_pop(L, 1);
+            entry.bytecode.clear();
+        }
+    }
+
+    const std::string chunk_name = "@" + path;
+    if (luaL_loadbufferx(L, source.data(), source.size(), chunk_name.c_str(), "t") != LUA_OK) {
+        throw PopLoadError(L);
+    }
+    // Keep debug info so errors still report file and line
+    lua_dump(L, WriteBytecode, &entry.bytecode, 0);
+    lua_pop(L, 1);
+    ++stats.compiles;
+
+    if (!cache_file.empty()) {
+        // Write then rename, so a concurrent run never reads a partial file
+        std::error_code error;
+        std::filesystem::create_directories(disk_directory, error);
+        std::filesystem::path temp_file = cache_file;
+        temp_file += ".tmp";
+        std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+        if (file && file.write(entry.bytecode.data(), entry.bytecode.size())) {
+            file.close();
+            std::filesystem::rename(temp_file, cache_file, error);
+        }
+        if (error || !file) {
+            std::cerr << "Failed to write script cache for " << path << "\n";
+        }
+    }
+
+    return entries[NormalizePath(path)] = std::move(entry);
+}
+
+void ScriptCache::SetDiskCacheDirectory(const std::string& directory) {
+    disk_directory = directory;
+}
+
+const std::string& ScriptCache::GetDiskCacheDirectory() const {
+    return disk_directory;
+}
+
+void ScriptCache::Invalidate(const std::string& path) {
+    entries.erase(NormalizePath(path));
+}
+
+void ScriptCache::Clear() {
+    entries.clear();
+}
+
+std::string ScriptCache::NormalizePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+size_t ScriptCache::GetCachedCount() const {
+    return entries.size();
+}
+
+const ScriptCacheStats& ScriptCache::GetStats() const {
+    return stats;
+}
+
+void ScriptCache::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table cache_table = lua.create_named_table("ScriptCache");
+    cache_table["get_stats"] = [](sol::this_state ts) {
+        sol::state_view lua(ts);
+        ScriptCache& cache = ScriptCache::GetInstance();
+        const ScriptCacheStats& stats = cache.GetStats();
+
+        sol::table result = lua.create_table();
+        result["compiles"] = stats.compiles;
+        result["disk_hits"] = stats.disk_hits;
+        result["hits"] = stats.hits;
+        result["runs"] = stats.runs;
+        result["reloads"] = stats.reloads;
+        result["cached"] = cache.GetCachedCount();
+        return result;
+    };
+    cache_table["invalidate"] = [](const std::string& path) {
+        ScriptCache::GetInstance().Invalidate(path);
+    };
+    cache_table["clear"] = []() {
+        ScriptCache::GetInstance().Clear();
+    };
+}
@@ -0,0 +1,258 @@
+#include <ScriptWatcher.hpp>
+#include <ScriptCache.hpp>
+#include <ScriptComponent.hpp>
+#include <Object.hpp>
+#include <RegistryManager.hpp>
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#endif
+
+namespace {
+
+bool IsScript(const std::filesystem::path& path) {
+    return path.extension() == ".lua";
+}
+
+// Entities of every live component (owners also hold a Component pointer, so skip those)
+std::unordered_set<entt::entity> GetComponentEntities() {
+    std::unordered_set<entt::entity> entities;
+    for (auto [entity, component] : RegistryManager::GetInstance().view<std::shared_ptr<Component>>().each()) {
+        if (component && component->entity == entity) {
+            entities.insert(entity);
+        }
+    }
+    return entities;
+}
+
+// Re-running a script that spawns at top level builds its components again; AddComponent
+// rejects the duplicates and Reload restores the globals that held the originals. Destroy
+// those: components created since existing was taken that never got an owner.
+void DestroyOrphanedComponents(const std::unordered_set<entt::entity>& existing) {
+    auto& registry = RegistryManager::GetInstance();
+    std::vector<entt::entity> orphans;
+    for (auto [entity, component] : registry.view<std::shared_ptr<Component>>().each()) {
+        if (component && component->entity == entity && component->owner_entity == entt::null && !existing.count(entity)) {
+            orphans.push_back(entity);
+        }
+    }
+    for (const entt::entity entity : orphans) {
+        registry.destroy(entity);
+    }
+}
+
+} // namespace
+
+ScriptWatcher& ScriptWatcher::GetInstance() {
+    static ScriptWatcher instance;
+    return instance;
+}
+
+ScriptWatcher::~ScriptWatcher() {
+    Stop();
+}
+
+bool ScriptWatcher::Watch(const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cerr << "Cannot watch scripts in " << directory << ": not a directory\n";
+        return false;
+    }
+
+#ifdef __linux__
+    if (inotify_fd < 0) {
+        inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            std::cerr << "Failed to start script watcher: inotify_init1 failed\n";
+            return false;
+        }
+    }
+    AddWatch(directory);
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (entry.is_directory()) {
+            AddWatch(entry.path().generic_string());
+        }
+    }
+#else
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (entry.is_regular_file() && IsScript(entry.path())) {
+            write_times[entry.path().generic_string()] = entry.last_write_time();
+        }
+    }
+    next_scan = std::chrono::steady_clock::now() + scan_interval;
+#endif
+
+    directories.push_back(directory);
+    std::cout << "Watching scripts in " << directory << "\n";
+    return true;
+}
+
+void ScriptWatcher::Stop() {
+#ifdef __linux__
+    if (inotify_fd >= 0) {
+        close(inotify_fd);
+        inotify_fd = -1;
+    }
+    watch_directories.clear();
+#else
+    write_times.clear();
+#endif
+    directories.clear();
+}
+
+bool ScriptWatcher::IsWatching() const {
+    return !directories.empty();
+}
+
+#ifdef __linux__
+void ScriptWatcher::AddWatch(const std::string& directory) {
+    // Editors either rewrite the file in place or rename a temporary over it
+    int wd = inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        std::cerr << "Failed to watch " << directory << "\n";
+        return;
+    }
+    watch_directories[wd] = directory;
+}
+
+void ScriptWatcher::CollectChanges(std::vector<std::string>& changed) {
+    if (inotify_fd < 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+    ssize_t length;
+    while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0) {
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            auto it = watch_directories.find(event->wd);
+            if (it == watch_directories.end() || event->len == 0) {
+                continue;
+            }
+            const std::filesystem::path path = std::filesystem::path(it->second) / event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    AddWatch(path.generic_string());
+                }
+            } else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && IsScript(path)) {
+                changed.push_back(path.generic_string());
+            }
+        }
+    }
+}
+#else
+void ScriptWatcher::CollectChanges(std::vector<std::string>& changed) {
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_scan) {
+        return;
+    }
+    next_scan = now + scan_interval;
+
+    std::error_code error;
+    for (const std::string& directory : directories) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            if (!entry.is_regular_file() || !IsScript(entry.path())) {
+                continue;
+            }
+            auto write_time = entry.last_write_time();
+            auto [it, inserted] = write_times.try_emplace(entry.path().generic_string(), write_time);
+            if (!inserted && it->second != write_time) {
+                it->second = write_time;
+                changed.push_back(it->first);
+            }
+        }
+    }
+}
+#endif
+
+void ScriptWatcher::Poll() {
+    if (directories.empty()) {
+        return;
+    }
+
+    std::vector<std::string> changed;
+    CollectChanges(changed);
+    if (changed.empty()) {
+        return;
+    }
+
+    // One save can raise several events; reload each file once
+    for (std::string& path : changed) {
+        path = ScriptCache::NormalizePath(path);
+    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    for (const std::string& path : changed) {
+        auto start = std::chrono::steady_clock::now();
+        size_t reloaded = Reload(path);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "Reloaded " << path << " into " << reloaded << " environment(s) in "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    }
+}
+
+size_t ScriptWatcher::Reload(const std::string& path) {
+    const std::string target = ScriptCache::NormalizePath(path);
+    if (!ScriptCache::GetInstance().Recompile(target)) {
+        return 0;
+    }
+
+    // Collect first: re-running a script may spawn objects and grow the storages we iterate
+    auto& registry = RegistryManager::GetInstance();
+    std::vector<std::shared_ptr<Object>> objects;
+    for (auto [entity, object] : registry.view<std::shared_ptr<Object>>().each()) {
+        if (!object->script_path.empty() && ScriptCache::NormalizePath(object->script_path) == target) {
+            objects.push_back(object);
+        }
+    }
+    std::vector<std::pair<std::shared_ptr<ScriptComponent>, std::string>> components;
+    for (auto [entity, component] : registry.view<std::shared_ptr<ScriptComponent>>().each()) {
+        for (const auto& [script_path, env] : component->scripts) {
+            if (ScriptCache::NormalizePath(script_path) == target) {
+                components.emplace_back(component, script_path);
+            }
+        }
+    }
+
+    const std::unordered_set<entt::entity> existing_components = GetComponentEntities();
+    size_t reloaded = 0;
+    for (auto& object : objects) {
+        try {
+            object->ReloadScript();
+            ++reloaded;
+        } catch (const std::exception& e) {
+            std::cerr << "Error reloading script for entity " << static_cast<int>(object->entity) << ": " << e.what() << "\n";
+        }
+    }
+    for (auto& [component, script_path] : components) {
+        try {
+            component->ReloadScript(script_path);
+            ++reloaded;
+        } catch (const std::exception& e) {
+            std::cerr << "Error reloading script for entity " << static_cast<int>(component->entity) << ": " << e.what() << "\n";
+        }
+    }
+    DestroyOrphanedComponents(existing_components);
+    return reloaded;
+}
+
+void ScriptWatcher::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table watcher_table = lua.create_named_table("ScriptWatcher");
+    // Returns the number of environments the script was re-run into
+    watcher_table["reload"] = [](const std::string& path) {
+        return ScriptWatcher::GetInstance().Reload(path);
+    };
+    watcher_table["is_watching"] = []() {
+        return ScriptWatcher::GetInstance().IsWatching();
+    };
+}
@@ -0,0 +1,440 @@
+#include <SpatialHash2D.hpp>
+#include <Object.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Reused between Lua queries
+std::vector<entt::entity> lua_results;
+std::vector<RaycastHit> lua_hits;
+
+bool Overlaps(const SpatialProxy& proxy, const Vector2& min, const Vector2& max) {
+    return proxy.min.x <= max.x && proxy.max.x >= min.x &&
+           proxy.min.y <= max.y && proxy.max.y >= min.y;
+}
+
+// Slab test against a normalized direction; distance is where the ray enters the box
+bool IntersectRay(const SpatialProxy& proxy, const Vector2& origin, const Vector2& direction, float max_distance, float& distance) {
+    float t_near = 0.0f;
+    float t_far = max_distance;
+    const float origins[2] = {origin.x, origin.y};
+    const float directions[2] = {direction.x, direction.y};
+    const float mins[2] = {proxy.min.x, proxy.min.y};
+    const float maxs[2] = {proxy.max.x, proxy.max.y};
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (directions[axis] == 0.0f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float inv = 1.0f / directions[axis];
+        float t1 = (mins[axis] - origins[axis]) * inv;
+        float t2 = (maxs[axis] - origins[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        t_near = std::max(t_near, t1);
+        t_far = std::min(t_far, t2);
+        if (t_near > t_far) {
+            return false;
+        }
+    }
+    distance = t_near;
+    return true;
+}
+
+entt::entity GetEntity(sol::environment& object) {
+    sol::optional<int> entity_id = object["entity"];
+    if (!entity_id) {
+        throw std::runtime_error("Entity not found in userdata environment.");
+    }
+    return static_cast<entt::entity>(entity_id.value());
+}
+
+// Map entities to their Object environments, skipping entities that aren't Objects
+sol::table ToObjects(const std::vector<entt::entity>& entities) {
+    auto& registry = RegistryManager::GetInstance();
+    sol::table result = LuaManager::GetInstance().create_table(static_cast<int>(entities.size()), 0);
+    int index = 1;
+    for (entt::entity entity : entities) {
+        if (auto* object = registry.try_get<std::shared_ptr<Object>>(entity)) {
+            result[index++] = (*object)->GetEnvironment();
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+SpatialHash2D& SpatialHash2D::GetInstance() {
+    static SpatialHash2D instance;
+    return instance;
+}
+
+SpatialHash2D::SpatialHash2D() {
+    RegistryManager::GetInstance().on_destroy<SpatialProxy>().connect<&SpatialHash2D::OnProxyDestroyed>(*this);
+}
+
+SpatialHash2D::~SpatialHash2D() {
+    RegistryManager::GetInstance().on_destroy<SpatialProxy>().disconnect(this);
+}
+
+SpatialHash2D::CellKey SpatialHash2D::MakeKey(int x, int y) {
+    return (static_cast<CellKey>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int SpatialHash2D::ToCell(float coordinate) const {
+    // Clamp before the cast (out-of-range floats are undefined behaviour); the margin keeps x + 1 from overflowing
+    const float cell = std::floor(coordinate * inv_cell_size);
+    if (std::isnan(cell)) {
+        return 0;
+    }
+    return static_cast<int>(std::clamp(cell, static_cast<float>(-cell_limit), static_cast<float>(cell_limit)));
+}
+
+int64_t SpatialHash2D::CellCount(int min_x, int min_y, int max_x, int max_y) {
+    if (max_x < min_x || max_y < min_y) {
+        return 0;
+    }
+    return (static_cast<int64_t>(max_x) - min_x + 1) * (static_cast<int64_t>(max_y) - min_y + 1);
+}
+
+template <typename Visitor>
+void SpatialHash2D::VisitCells(int min_x, int min_y, int max_x, int max_y, Visitor&& visit) {
+    const int64_t count = CellCount(min_x, min_y, max_x, max_y);
+    if (count == 0) {
+        return;
+    }
+
+    // A range larger than the occupied grid is cheaper to answer from the occupied cells
+    if (static_cast<uint64_t>(count) > cells.size()) {
+        for (auto& [key, bucket] : cells) {
+            const int x = static_cast<int>(static_cast<uint32_t>(key >> 32));
+            const int y = static_cast<int>(static_cast<uint32_t>(key));
+            if (x >= min_x && x <= max_x && y >= min_y && y <= max_y) {
+                visit(bucket);
+            }
+        }
+        return;
+    }
+
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            auto it = cells.find(MakeKey(x, y));
+            if (it != cells.end()) {
+                visit(it->second);
+            }
+        }
+    }
+}
+
+void SpatialHash2D::Insert(entt::entity entity, SpatialProxy& proxy) {
+    if (CellCount(proxy.cell_min_x, proxy.cell_min_y, proxy.cell_max_x, proxy.cell_max_y) > max_proxy_cells) {
+        oversized.push_back(entity);
+        proxy.oversized = true;
+        return;
+    }
+    for (int y = proxy.cell_min_y; y <= proxy.cell_max_y; ++y) {
+        for (int x = proxy.cell_min_x; x <= proxy.cell_max_x; ++x) {
+            cells[MakeKey(x, y)].push_back(entity);
+        }
+    }
+}
+
+void SpatialHash2D::Remove(entt::entity entity, SpatialProxy& proxy) {
+    if (proxy.oversized) {
+        auto found = std::find(oversized.begin(), oversized.end(), entity);
+        if (found != oversized.end()) {
+            *found = oversized.back();
+            oversized.pop_back();
+        }
+        proxy.oversized = false;
+        proxy.cell_min_x = proxy.cell_min_y = 0;
+        proxy.cell_max_x = proxy.cell_max_y = -1;
+        return;
+    }
+    for (int y = proxy.cell_min_y; y <= proxy.cell_max_y; ++y) {
+        for (int x = proxy.cell_min_x; x <= proxy.cell_max_x; ++x) {
+            auto it = cells.find(MakeKey(x, y));
+            if (it == cells.end()) continue;
+
+            auto& bucket = it->second;
+            auto found = std::find(bucket.begin(), bucket.end(), entity);
+            if (found != bucket.end()) {
+                *found = bucket.back();
+                bucket.pop_back();
+            }
+            if (bucket.empty()) {
+                cells.erase(it);
+            }
+        }
+    }
+    proxy.cell_min_x = proxy.cell_min_y = 0;
+    proxy.cell_max_x = proxy.cell_max_y = -1;
+}
+
+void SpatialHash2D::OnProxyDestroyed(entt::registry& registry, entt::entity entity) {
+    Remove(entity, registry.get<SpatialProxy>(entity));
+}
+
+void SpatialHash2D::Update() {
+    auto& registry = RegistryManager::GetInstance();
+    stats.rebucketed = 0;
+    stats.refreshed = 0;
+
+    // Start tracking Object2Ds spawned since the last update
+    std::vector<entt::entity> spawned;
+    for (auto entity : registry.view<Transform2D, Object2DTag>(entt::exclude<SpatialProxy>)) {
+        spawned.push_back(entity);
+    }
+    for (auto entity : spawned) {
+        registry.emplace<SpatialProxy>(entity);
+    }
+
+    for (auto [entity, transform, proxy] : registry.view<Transform2D, SpatialProxy>().each()) {
+        if (!transform.changed && !proxy.extents_dirty) {
+            continue;
+        }
+
+        proxy.min = transform.global_position - proxy.half_extents;
+        proxy.max = transform.global_position + proxy.half_extents;
+        proxy.extents_dirty = false;
+        ++stats.refreshed;
+
+        int min_x = ToCell(proxy.min.x), min_y = ToCell(proxy.min.y);
+        int max_x = ToCell(proxy.max.x), max_y = ToCell(proxy.max.y);
+        if (min_x == proxy.cell_min_x && min_y == proxy.cell_min_y &&
+            max_x == proxy.cell_max_x && max_y == proxy.cell_max_y) {
+            continue;
+        }
+
+        Remove(entity, proxy);
+        proxy.cell_min_x = min_x;
+        proxy.cell_min_y = min_y;
+        proxy.cell_max_x = max_x;
+        proxy.cell_max_y = max_y;
+        Insert(entity, proxy);
+        ++stats.rebucketed;
+    }
+
+    stats.tracked = registry.storage<SpatialProxy>().size();
+    stats.cells = cells.size();
+    stats.oversized = oversized.size();
+}
+
+void SpatialHash2D::SetExtents(entt::entity entity, const Vector2& half_extents) {
+    auto& registry = RegistryManager::GetInstance();
+    if (!registry.all_of<Transform2D>(entity)) {
+        std::cerr << "SpatialHash2D: entity " << static_cast<int>(entity) << " has no Transform2D.\n";
+        return;
+    }
+    auto& proxy = registry.get_or_emplace<SpatialProxy>(entity);
+    proxy.half_extents = Vector2::Abs(half_extents);
+    proxy.extents_dirty = true;
+}
+
+void SpatialHash2D::SetCellSize(float size) {
+    if (size <= 0.0f) {
+        std::cerr << "SpatialHash2D: cell size must be positive.\n";
+        return;
+    }
+    cell_size = size;
+    inv_cell_size = 1.0f / size;
+    Clear();
+}
+
+float SpatialHash2D::GetCellSize() const {
+    return cell_size;
+}
+
+void SpatialHash2D::Clear() {
+    cells.clear();
+    oversized.clear();
+    for (auto [entity, proxy] : RegistryManager::GetInstance().view<SpatialProxy>().each()) {
+        proxy.cell_min_x = proxy.cell_min_y = 0;
+        proxy.cell_max_x = proxy.cell_max_y = -1;
+        proxy.extents_dirty = true;
+        proxy.oversized = false;
+    }
+    stats.cells = 0;
+    stats.oversized = 0;
+}
+
+uint32_t SpatialHash2D::NextQueryStamp() {
+    if (++query_stamp == 0) {
+        // Wrapped around: old stamps could collide with new ones
+        for (auto [entity, proxy] : RegistryManager::GetInstance().view<SpatialProxy>().each()) {
+            proxy.query_stamp = 0;
+        }
+        query_stamp = 1;
+    }
+    return query_stamp;
+}
+
+void SpatialHash2D::QueryAABB(const Vector2& min, const Vector2& max, std::vector<entt::entity>& out) {
+    if (!std::isfinite(min.x) || !std::isfinite(min.y) || !std::isfinite(max.x) || !std::isfinite(max.y)) {
+        return;
+    }
+    auto& storage = RegistryManager::GetInstance().storage<SpatialProxy>();
+    const uint32_t stamp = NextQueryStamp();
+
+    auto visit = [&](const std::vector<entt::entity>& bucket) {
+        for (entt::entity entity : bucket) {
+            SpatialProxy& proxy = storage.get(entity);
+            if (proxy.query_stamp == stamp) continue;
+            proxy.query_stamp = stamp;
+            if (Overlaps(proxy, min, max)) {
+                out.push_back(entity);
+            }
+        }
+    };
+    VisitCells(ToCell(min.x), ToCell(min.y), ToCell(max.x), ToCell(max.y), visit);
+    visit(oversized);
+}
+
+void SpatialHash2D::QueryRadius(const Vector2& center, float radius, std::vector<entt::entity>& out) {
+    if (!std::isfinite(center.x) || !std::isfinite(center.y) || !std::isfinite(radius) || radius < 0.0f) {
+        return;
+    }
+    auto& storage = RegistryManager::GetInstance().storage<SpatialProxy>();
+    const uint32_t stamp = NextQueryStamp();
+    const float radius_squared = radius * radius;
+
+    auto visit = [&](const std::vector<entt::entity>& bucket) {
+        for (entt::entity entity : bucket) {
+            SpatialProxy& proxy = storage.get(entity);
+            if (proxy.query_stamp == stamp) continue;
+            proxy.query_stamp = stamp;
+
+            // Distance from the center to the closest point of the AABB
+            Vector2 closest = Vector2::Clamp(center, proxy.min, proxy.max);
+            Vector2 offset = center - closest;
+            if (offset.x * offset.x + offset.y * offset.y <= radius_squared) {
+                out.push_back(entity);
+            }
+        }
+    };
+    VisitCells(ToCell(center.x - radius), ToCell(center.y - radius),
+               ToCell(center.x + radius), ToCell(center.y + radius), visit);
+    visit(oversized);
+}
+
+void SpatialHash2D::Raycast(const Vector2& origin, const Vector2& direction, float max_distance, std::vector<RaycastHit>& out) {
+    float length = Vector2::Magnitude(direction);
+    if (length == 0.0f || !std::isfinite(length) || !(max_distance > 0.0f) || !std::isfinite(max_distance) ||
+        !std::isfinite(origin.x) || !std::isfinite(origin.y)) {
+        return;
+    }
+    const Vector2 dir = direction / length;
+    auto& storage = RegistryManager::GetInstance().storage<SpatialProxy>();
+    const uint32_t stamp = NextQueryStamp();
+    const size_t first_hit = out.size();
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    auto visit = [&](const std::vector<entt::entity>& bucket) {
+        for (entt::entity entity : bucket) {
+            SpatialProxy& proxy = storage.get(entity);
+            if (proxy.query_stamp == stamp) continue;
+            proxy.query_stamp = stamp;
+
+            float distance = 0.0f;
+            if (IntersectRay(proxy, origin, dir, max_distance, distance)) {
+                out.push_back({entity, distance});
+            }
+        }
+    };
+    visit(oversized);
+
+    // Upper bound on the cells the ray crosses; past the occupied count, test the occupied cells instead
+    const double max_steps = 2.0 * static_cast<double>(max_distance) * inv_cell_size + 2.0;
+    if (max_steps > static_cast<double>(cells.size())) {
+        for (auto& [key, bucket] : cells) {
+            visit(bucket);
+        }
+    } else {
+        // Walk the cells the ray crosses (Amanatides & Woo)
+        int x = ToCell(origin.x);
+        int y = ToCell(origin.y);
+        const int step_x = dir.x > 0.0f ? 1 : (dir.x < 0.0f ? -1 : 0);
+        const int step_y = dir.y > 0.0f ? 1 : (dir.y < 0.0f ? -1 : 0);
+        const float delta_x = step_x != 0 ? cell_size / std::abs(dir.x) : infinity;
+        const float delta_y = step_y != 0 ? cell_size / std::abs(dir.y) : infinity;
+        float next_x = step_x != 0 ? ((x + (step_x > 0 ? 1 : 0)) * cell_size - origin.x) / dir.x : infinity;
+        float next_y = step_y != 0 ? ((y + (step_y > 0 ? 1 : 0)) * cell_size - origin.y) / dir.y : infinity;
+
+        // The step cap also ends the walk if float precision stalls t far from the origin
+        float t = 0.0f;
+        for (size_t steps = 0; t <= max_distance && steps <= static_cast<size_t>(max_steps); ++steps) {
+            auto it = cells.find(MakeKey(x, y));
+            if (it != cells.end()) {
+                visit(it->second);
+            }
+
+            if (next_x < next_y) {
+                t = next_x;
+                next_x += delta_x;
+                x += step_x;
+            } else {
+                t = next_y;
+                next_y += delta_y;
+                y += step_y;
+            }
+        }
+    }
+
+    std::sort(out.begin() + first_hit, out.end(), [](const RaycastHit& lhs, const RaycastHit& rhs) {
+        return lhs.distance < rhs.distance;
+    });
+}
+
+const SpatialHashStats& SpatialHash2D::GetStats() const {
+    return stats;
+}
+
+void SpatialHash2D::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table spatial_table = lua.create_named_table("SpatialHash");
+    spatial_table["set_extents"] = [](sol::environment object, float half_width, float half_height) {
+        SpatialHash2D::GetInstance().SetExtents(GetEntity(object), Vector2(half_width, half_height));
+    };
+    spatial_table["set_cell_size"] = [](float size) {
+        SpatialHash2D::GetInstance().SetCellSize(size);
+    };
+    spatial_table["query_radius"] = [](float x, float y, float radius) {
+        lua_results.clear();
+        SpatialHash2D::GetInstance().QueryRadius(Vector2(x, y), radius, lua_results);
+        return ToObjects(lua_results);
+    };
+    spatial_table["query_aabb"] = [](float min_x, float min_y, float max_x, float max_y) {
+        lua_results.clear();
+        SpatialHash2D::GetInstance().QueryAABB(Vector2(min_x, min_y), Vector2(max_x, max_y), lua_results);
+        return ToObjects(lua_results);
+    };
+    // Returns { { object = ..., distance = ... }, ... } nearest first
+    spatial_table["raycast"] = [](float x, float y, float dir_x, float dir_y, float max_distance) {
+        auto& registry = RegistryManager::GetInstance();
+        sol::state& lua = LuaManager::GetInstance();
+        lua_hits.clear();
+        SpatialHash2D::GetInstance().Raycast(Vector2(x, y), Vector2(dir_x, dir_y), max_distance, lua_hits);
+
+        sol::table result = lua.create_table(static_cast<int>(lua_hits.size()), 0);
+        int index = 1;
+        for (const RaycastHit& hit : lua_hits) {
+            if (auto* object = registry.try_get<std::shared_ptr<Object>>(hit.entity)) {
+                result[index++] = lua.create_table_with("object", (*object)->GetEnvironment(), "distance", hit.distance);
+            }
+        }
+        return result;
+    };
+    spatial_table["get_stats"] = []() {
+        const SpatialHashStats& stats = SpatialHash2D::GetInstance().GetStats();
+        return LuaManager::GetInstance().create_table_with(
+            "tracked", stats.tracked,
+            "cells", stats.cells,
+            "oversized", stats.oversized,
+            "rebucketed", stats.rebucketed,
+            "refreshed", stats.refreshed);
+    };
+}
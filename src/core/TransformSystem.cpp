@@ -0,0 +1,191 @@
+#include <TransformSystem.hpp>
+#include <JobSystem.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+// Compose a child's local values onto its parent's world values
+void Compose(const Transform2D* parent, Transform2D& transform) {
+    if (!parent) {
+        transform.global_position = transform.position;
+        transform.global_rotation = transform.rotation;
+        transform.global_scale = transform.scale;
+        return;
+    }
+    Vector2 offset = transform.position * parent->global_scale;
+    if (parent->global_rotation != 0.0f) {
+        offset = Vector2::Rotate(offset, parent->global_rotation);
+    }
+    transform.global_position = parent->global_position + offset;
+    transform.global_rotation = parent->global_rotation + transform.rotation;
+    transform.global_scale = parent->global_scale * transform.scale;
+}
+
+// Derive local position from a world position written directly
+void Decompose(const Transform2D* parent, Transform2D& transform) {
+    if (!parent) {
+        transform.position = transform.global_position;
+        return;
+    }
+    Vector2 offset = transform.global_position - parent->global_position;
+    if (parent->global_rotation != 0.0f) {
+        offset = Vector2::Rotate(offset, -parent->global_rotation);
+    }
+    transform.position = Vector2(
+        parent->global_scale.x != 0.0f ? offset.x / parent->global_scale.x : 0.0f,
+        parent->global_scale.y != 0.0f ? offset.y / parent->global_scale.y : 0.0f);
+}
+
+// Nodes on the same depth only read their parents, so a level can be split across workers
+constexpr size_t transform_grain = 1024;
+
+void Resolve(entt::storage_for_t<Transform2D>& storage, entt::entity entity) {
+    Transform2D& transform = storage.get(entity);
+    const Transform2D* parent = transform.parent != entt::null ? &storage.get(transform.parent) : nullptr;
+
+    transform.previous_global_position = transform.last_global_position;
+
+    // Lua may write the position tables directly, bypassing the setters
+    bool local_written = transform.position != transform.last_position;
+    bool global_written = transform.global_position != transform.last_global_position;
+    if (global_written && !local_written) {
+        Decompose(parent, transform);
+    }
+
+    transform.changed = transform.dirty || local_written || global_written || (parent && parent->changed);
+    if (transform.changed) {
+        Compose(parent, transform);
+    }
+
+    if (!transform.initialized) {
+        transform.previous_global_position = transform.global_position;
+        transform.initialized = true;
+    }
+
+    transform.dirty = false;
+    transform.last_position = transform.position;
+    transform.last_global_position = transform.global_position;
+}
+
+} // namespace
+
+TransformSystem& TransformSystem::GetInstance() {
+    static TransformSystem instance;
+    return instance;
+}
+
+TransformSystem::TransformSystem() {
+    auto& registry = RegistryManager::GetInstance();
+    registry.on_construct<Transform2D>().connect<&TransformSystem::OnTransformChanged>(*this);
+    registry.on_destroy<Transform2D>().connect<&TransformSystem::OnTransformChanged>(*this);
+}
+
+TransformSystem::~TransformSystem() {
+    auto& registry = RegistryManager::GetInstance();
+    registry.on_construct<Transform2D>().disconnect(this);
+    registry.on_destroy<Transform2D>().disconnect(this);
+}
+
+void TransformSystem::OnTransformChanged(entt::registry&, entt::entity) {
+    hierarchy_dirty = true;
+}
+
+void TransformSystem::MarkHierarchyDirty() {
+    hierarchy_dirty = true;
+}
+
+void TransformSystem::SetParent(entt::entity entity, entt::entity parent) {
+    auto& registry = RegistryManager::GetInstance();
+    auto* transform = registry.try_get<Transform2D>(entity);
+    if (!transform) {
+        return;
+    }
+
+    // Only 2D parents contribute to the world transform
+    transform->parent = (parent != entt::null && registry.all_of<Transform2D>(parent)) ? parent : entt::null;
+    transform->dirty = true;
+    hierarchy_dirty = true;
+}
+
+void TransformSystem::SetPosition(entt::entity entity, const Vector2& position) {
+    auto& registry = RegistryManager::GetInstance();
+    auto& transform = registry.get<Transform2D>(entity);
+    transform.position = position;
+    Compose(registry.try_get<Transform2D>(transform.parent), transform);
+    transform.dirty = true;
+}
+
+void TransformSystem::SetGlobalPosition(entt::entity entity, const Vector2& global_position) {
+    auto& registry = RegistryManager::GetInstance();
+    auto& transform = registry.get<Transform2D>(entity);
+    transform.global_position = global_position;
+    Decompose(registry.try_get<Transform2D>(transform.parent), transform);
+    transform.dirty = true;
+}
+
+void TransformSystem::RebuildOrder() {
+    auto& registry = RegistryManager::GetInstance();
+    auto view = registry.view<Transform2D>();
+
+    // Detach from parents that were destroyed or lost their transform
+    for (auto [entity, transform] : view.each()) {
+        if (transform.parent != entt::null && !registry.all_of<Transform2D>(transform.parent)) {
+            transform.parent = entt::null;
+            transform.dirty = true;
+        }
+    }
+
+    // Depth of each node, memoized while walking up the parent chain
+    std::unordered_map<entt::entity, int> depths;
+    std::vector<entt::entity> chain;
+    for (auto entity : view) {
+        entt::entity current = entity;
+        int depth = 0;
+        while (current != entt::null) {
+            auto it = depths.find(current);
+            if (it != depths.end()) {
+                depth = it->second + 1;
+                break;
+            }
+            chain.push_back(current);
+            auto* transform = registry.try_get<Transform2D>(current);
+            current = transform ? transform->parent : entt::null;
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            depths[*it] = depth++;
+        }
+        chain.clear();
+    }
+
+    update_order.assign(view.begin(), view.end());
+    std::stable_sort(update_order.begin(), update_order.end(), [&](entt::entity lhs, entt::entity rhs) {
+        return depths[lhs] < depths[rhs];
+    });
+
+    level_starts.clear();
+    for (size_t i = 0; i < update_order.size(); ++i) {
+        if (i == 0 || depths[update_order[i]] != depths[update_order[i - 1]]) {
+            level_starts.push_back(i);
+        }
+    }
+    level_starts.push_back(update_order.size());
+    hierarchy_dirty = false;
+}
+
+void TransformSystem::Update() {
+    if (hierarchy_dirty) {
+        RebuildOrder();
+    }
+
+    auto& storage = RegistryManager::GetInstance().storage<Transform2D>();
+    JobSystem& jobs = JobSystem::GetInstance();
+    for (size_t level = 0; level + 1 < level_starts.size(); ++level) {
+        const size_t first = level_starts[level];
+        jobs.ParallelFor("transform_level", level_starts[level + 1] - first, transform_grain, [&](size_t begin, size_t end) {
+            for (size_t i = first + begin; i < first + end; ++i) {
+                Resolve(storage, update_order[i]);
+            }
+        });
+    }
+}
@@ -0,0 +1,112 @@
+#include <AtlasBuilder.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace {
+
+struct SourceImage {
+    std::string path;
+    SDL_Surface* surface;
+    SDL_Rect rect;
+};
+
+// Try to place every image on a width x height page, tallest first
+bool PackAll(std::vector<SourceImage>& images, int width, int height) {
+    AtlasPacker packer(width, height);
+    for (SourceImage& image : images) {
+        SDL_Rect rect;
+        if (!packer.Insert(image.surface->w + AtlasBuilder::padding, image.surface->h + AtlasBuilder::padding, rect)) {
+            return false;
+        }
+        image.rect = {rect.x, rect.y, image.surface->w, image.surface->h};
+    }
+    return true;
+}
+
+} // namespace
+
+int AtlasBuilder::Run(const std::string& output, const std::vector<std::string>& inputs) {
+    if (inputs.empty()) {
+        std::cerr << "Usage: --pack-atlas <output.png> <image>...\n";
+        return -1;
+    }
+
+    std::vector<SourceImage> images;
+    long long area = 0;
+    for (const std::string& path : inputs) {
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        SDL_Surface* surface = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+        if (loaded) SDL_FreeSurface(loaded);
+        if (!surface) {
+            std::cerr << "Failed to load " << path << ": " << IMG_GetError() << "\n";
+            for (SourceImage& image : images) SDL_FreeSurface(image.surface);
+            return -1;
+        }
+        area += static_cast<long long>(surface->w + padding) * (surface->h + padding);
+        images.push_back({path, surface, {0, 0, 0, 0}});
+    }
+
+    std::sort(images.begin(), images.end(), [](const SourceImage& lhs, const SourceImage& rhs) {
+        return lhs.surface->h != rhs.surface->h ? lhs.surface->h > rhs.surface->h : lhs.surface->w > rhs.surface->w;
+    });
+
+    // Smallest power-of-two page that holds everything, growing the shorter side first
+    int width = 1;
+    while (static_cast<long long>(width) * width < area) width *= 2;
+    int height = width;
+    while (!PackAll(images, width, height)) {
+        if (width >= max_size && height >= max_size) {
+            std::cerr << "Images don't fit in a " << max_size << "x" << max_size << " atlas\n";
+            for (SourceImage& image : images) SDL_FreeSurface(image.surface);
+            return -1;
+        }
+        if (width <= height) width = std::min(width * 2, max_size);
+        else height = std::min(height * 2, max_size);
+    }
+    // The first guess may be larger than needed in one direction
+    while (height > 1 && PackAll(images, width, height / 2)) height /= 2;
+    PackAll(images, width, height);
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!atlas) {
+        std::cerr << "Failed to create atlas surface: " << SDL_GetError() << "\n";
+        for (SourceImage& image : images) SDL_FreeSurface(image.surface);
+        return -1;
+    }
+    SDL_FillRect(atlas, nullptr, 0);
+    for (SourceImage& image : images) {
+        // Copy pixels and alpha as-is rather than blending onto the blank page
+        SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+        SDL_Rect destination = image.rect;
+        SDL_BlitSurface(image.surface, nullptr, atlas, &destination);
+    }
+
+    int result = 0;
+    if (IMG_SavePNG(atlas, output.c_str()) != 0) {
+        std::cerr << "Failed to write " << output << ": " << IMG_GetError() << "\n";
+        result = -1;
+    } else {
+        std::filesystem::path metadata_path = std::filesystem::path(output).replace_extension(".atlas");
+        std::ofstream metadata(metadata_path);
+        metadata << "# Generated by --pack-atlas\n";
+        metadata << "image " << std::filesystem::path(output).filename().generic_string() << " " << width << " " << height << "\n";
+        for (const SourceImage& image : images) {
+            metadata << "sprite " << image.rect.x << " " << image.rect.y << " " << image.rect.w << " " << image.rect.h
+                     << " " << image.path << "\n";
+        }
+
+        long long used = std::accumulate(images.begin(), images.end(), 0LL, [](long long sum, const SourceImage& image) {
+            return sum + static_cast<long long>(image.rect.w) * image.rect.h;
+        });
+        std::cout << "Packed " << images.size() << " images into " << width << "x" << height << " ("
+                  << std::lround(100.0 * used / (static_cast<double>(width) * height)) << "% used): "
+                  << output << ", " << metadata_path.generic_string() << "\n";
+    }
+
+    SDL_FreeSurface(atlas);
+    for (SourceImage& image : images) SDL_FreeSurface(image.surface);
+    return result;
+}
@@ -0,0 +1,110 @@
+#include <AtlasPacker.hpp>
+#include <algorithm>
+#include <climits>
+
+AtlasPacker::AtlasPacker(int width, int height) {
+    Reset(width, height);
+}
+
+void AtlasPacker::Reset(int new_width, int new_height) {
+    width = new_width;
+    height = new_height;
+    used_area = 0;
+    skyline.clear();
+    if (width > 0 && height > 0) {
+        skyline.push_back({0, 0, width});
+    }
+}
+
+int AtlasPacker::Fit(size_t index, int rect_width, int rect_height) const {
+    const int x = skyline[index].x;
+    if (x + rect_width > width) {
+        return -1;
+    }
+
+    // The rectangle rests on the highest segment it spans
+    int y = 0;
+    int remaining = rect_width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, skyline[i].y);
+        if (y + rect_height > height) {
+            return -1;
+        }
+        remaining -= skyline[i].width;
+    }
+    return y;
+}
+
+bool AtlasPacker::Insert(int rect_width, int rect_height, SDL_Rect& rect) {
+    if (rect_width <= 0 || rect_height <= 0) {
+        return false;
+    }
+
+    // Lowest top edge wins; ties go to the narrower segment to limit wasted gaps
+    size_t best_index = skyline.size();
+    int best_top = INT_MAX;
+    int best_width = INT_MAX;
+    int best_y = 0;
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y = Fit(i, rect_width, rect_height);
+        if (y < 0) {
+            continue;
+        }
+        int top = y + rect_height;
+        if (top < best_top || (top == best_top && skyline[i].width < best_width)) {
+            best_index = i;
+            best_top = top;
+            best_width = skyline[i].width;
+            best_y = y;
+        }
+    }
+    if (best_index == skyline.size()) {
+        return false;
+    }
+
+    rect = {skyline[best_index].x, best_y, rect_width, rect_height};
+    skyline.insert(skyline.begin() + best_index, {rect.x, best_top, rect_width});
+
+    // Trim the segments now covered by the new one
+    for (size_t i = best_index + 1; i < skyline.size();) {
+        const Segment& previous = skyline[i - 1];
+        int overlap = previous.x + previous.width - skyline[i].x;
+        if (overlap <= 0) {
+            break;
+        }
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0) {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    used_area += static_cast<long long>(rect_width) * rect_height;
+    return true;
+}
+
+int AtlasPacker::GetWidth() const {
+    return width;
+}
+
+int AtlasPacker::GetHeight() const {
+    return height;
+}
+
+float AtlasPacker::GetOccupancy() const {
+    if (width <= 0 || height <= 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(static_cast<double>(used_area) / (static_cast<double>(width) * height));
+}
@@ -0,0 +1,90 @@
+#include <RenderThread.hpp>
+#include <Renderer2D.hpp>
+#include <TextureCache.hpp>
+#include <Profiler.hpp>
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+bool RenderThread::Start(RendererFactory create_renderer) {
+    if (thread.joinable()) {
+        std::cerr << "Render thread is already running.\n";
+        return true;
+    }
+
+    stopping = false;
+    std::promise<bool> started;
+    std::future<bool> result = started.get_future();
+    thread = std::thread(&RenderThread::Loop, this, std::move(create_renderer), std::ref(started));
+    if (!result.get()) {
+        thread.join();
+        return false;
+    }
+    return true;
+}
+
+void RenderThread::Stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+RenderCommandList& RenderThread::GetFrameCommands() {
+    return buffer.GetWriteList();
+}
+
+void RenderThread::Submit() {
+    buffer.Publish();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    wake.notify_one();
+}
+
+uint64_t RenderThread::GetPresentedFrames() const {
+    return presented;
+}
+
+void RenderThread::Loop(RendererFactory create_renderer, std::promise<bool>& started) {
+    Profiler::SetThreadName("render");
+    SDL_Renderer* renderer = create_renderer();
+    if (!renderer) {
+        started.set_value(false);
+        return;
+    }
+    Renderer2D& renderer_2d = Renderer2D::GetInstance();
+    renderer_2d.Initialize(renderer);
+    started.set_value(true);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return pending || stopping; });
+            if (stopping) {
+                break;
+            }
+            pending = false;
+        }
+
+        // Frames published while we were drawing are skipped; only the newest is shown
+        if (buffer.AcquireLatest()) {
+            renderer_2d.Execute(buffer.GetReadList());
+            ProfileZone zone("SDL_RenderPresent");
+            SDL_RenderPresent(renderer);
+            ++presented;
+        }
+    }
+
+    // The simulation is stopped, so the cache can be cleared from here
+    TextureCache::GetInstance().Clear();
+    renderer_2d.Shutdown();
+    SDL_DestroyRenderer(renderer);
+}
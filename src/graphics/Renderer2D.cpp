@@ -1,4 +1,6 @@
 #include <Renderer2D.hpp>
+#include <JobSystem.hpp>
+#include <Profiler.hpp>
 
 Renderer2D& Renderer2D::GetInstance() {
     static Renderer2D instance;
@@ -8,16 +10,39 @@ Renderer2D& Renderer2D::GetInstance() {
 void Renderer2D::Initialize(SDL_Renderer* sdlRenderer) {
     if (!renderer) {
         renderer = sdlRenderer;
+        SDL_Rect viewport;
+        SDL_RenderGetViewport(renderer, &viewport);
+        viewport_width = viewport.w;
+        viewport_height = viewport.h;
     } else {
         std::cerr << "Renderer is already initialized.\n";
     }
 }
 
-void Renderer2D::Render(float frame_duration) {
+void Renderer2D::Shutdown() {
+    if (placeholder_texture) {
+        SDL_DestroyTexture(placeholder_texture);
+        placeholder_texture = nullptr;
+    }
+    renderer = nullptr;
+}
+
+void Renderer2D::Render(float frame_duration, float alpha) {
+    ProfileZone zone("Renderer2D::Render");
     if (!renderer) {
         std::cerr << "Renderer is not initialized.\n";
         return;
     }
+    BuildCommands(immediate_commands, frame_duration, alpha);
+    Execute(immediate_commands);
+}
+
+void Renderer2D::BuildCommands(RenderCommandList& commands, float frame_duration, float alpha) {
+    ProfileZone zone("Renderer2D::BuildCommands");
+    commands.Reset();
+    commands.generation = TextureCache::GetInstance().AdvanceGeneration();
+    commands.clear_color = clear_color;
+    commands.draw_placeholders = placeholders_enabled;
 
     auto& registry = RegistryManager::GetInstance();
 
@@ -29,20 +54,13 @@ void Renderer2D::Render(float frame_duration) {
     float smooth = 0.0f;
 
     // Find the active camera
-    auto cameraView = registry.view<std::shared_ptr<Object>, std::string, std::shared_ptr<CameraComponent>>();
-    for (auto entity : cameraView) {
-        auto& obj = cameraView.get<std::shared_ptr<Object>>(entity);
-        auto& type = cameraView.get<std::string>(entity);
-        auto& camera = cameraView.get<std::shared_ptr<CameraComponent>>(entity);
-
-        if (type == "Object2D" && camera->current) {
-            auto obj2D = std::dynamic_pointer_cast<Object2D>(obj);
-            if (obj2D) {
-                target_camera_position = obj2D->GetGlobalPosition();
-                camera_zoom = camera->GetZoom();
-                centered = camera->GetCentered();
-                smooth = camera->GetSmooth();
-            }
+    auto cameraView = registry.view<Transform2D, std::shared_ptr<CameraComponent>>();
+    for (auto [entity, transform, camera] : cameraView.each()) {
+        if (camera->current) {
+            target_camera_position = Vector2::Lerp(transform.previous_global_position, transform.global_position, alpha);
+            camera_zoom = camera->GetZoom();
+            centered = camera->GetCentered();
+            smooth = camera->GetSmooth();
             break;
         }
     }
@@ -63,36 +81,169 @@ void Renderer2D::Render(float frame_duration) {
         last_camera_position = target_camera_position;
     }
 
+    // Size from the last executed frame; the simulation never queries SDL
+    const float view_width = static_cast<float>(viewport_width.load());
+    const float view_height = static_cast<float>(viewport_height.load());
+
     // Adjust for centering
     if (centered) {
-        SDL_Rect viewport;
-        SDL_RenderGetViewport(renderer, &viewport);
-        camera_position.x -= viewport.w / (2 * camera_zoom);
-        camera_position.y -= viewport.h / (2 * camera_zoom);
+        camera_position.x -= view_width / (2 * camera_zoom);
+        camera_position.y -= view_height / (2 * camera_zoom);
     }
+    commands.camera_position = camera_position;
+    commands.camera_zoom = camera_zoom;
 
-    // Render objects with SpriteComponent, adjusted for the camera
-    auto objectView = registry.view<std::shared_ptr<Object>, std::string, std::shared_ptr<SpriteComponent>>();
-    for (auto entity : objectView) {
-        auto& obj = objectView.get<std::shared_ptr<Object>>(entity);
-        auto& type = objectView.get<std::string>(entity);
-        auto& sprite = objectView.get<std::shared_ptr<SpriteComponent>>(entity);
+    // Record objects with SpriteComponent, adjusted for the camera
+    visible_count = 0;
+    culled_count = 0;
+    sprite_draws.clear();
+    auto objectView = registry.view<Transform2D, std::shared_ptr<SpriteComponent>>();
+    for (auto [entity, transform, sprite] : objectView.each()) {
+        sprite_draws.push_back({sprite.get(), &transform, Vector2(), true});
+    }
 
-        if (type == "Object2D") {
-            auto obj2D = std::dynamic_pointer_cast<Object2D>(obj);
-            if (obj2D) {
-                Vector2 obj_position = obj2D->GetGlobalPosition();
+    // Position and cull on the job pool; only quad submission has to stay serial
+    JobSystem::GetInstance().ParallelFor("cull_sprites", sprite_draws.size(), cull_grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            SpriteDraw& draw = sprite_draws[i];
+            Vector2 obj_position = Vector2::Lerp(draw.transform->previous_global_position, draw.transform->global_position, alpha);
 
-                // Adjust position based on the camera and zoom
-                Vector2 render_position = (obj_position - camera_position) * camera_zoom;
+            // Adjust position based on the camera and zoom
+            draw.render_position = (obj_position - camera_position) * camera_zoom;
 
-                // Delegate rendering to SpriteComponent
-                sprite->Render(renderer, static_cast<int>(render_position.x), static_cast<int>(render_position.y));
+            // Skip sprites whose frame lies entirely outside the viewport. Sprites without a
+            // loaded texture have no size yet and go through Render so it can load them.
+            if (culling_enabled && draw.sprite->HasCurrentTexture()) {
+                float half_width = draw.sprite->frame_coords.w * 0.5f;
+                float half_height = draw.sprite->frame_coords.h * 0.5f;
+                draw.visible = !(draw.render_position.x + half_width < 0.0f || draw.render_position.x - half_width > view_width ||
+                                 draw.render_position.y + half_height < 0.0f || draw.render_position.y - half_height > view_height);
             }
         }
+    });
+
+    for (const SpriteDraw& draw : sprite_draws) {
+        if (!draw.visible) {
+            ++culled_count;
+            continue;
+        }
+        ++visible_count;
+
+        // Delegate quad generation to SpriteComponent
+        draw.sprite->Render(commands, static_cast<int>(draw.render_position.x), static_cast<int>(draw.render_position.y));
+    }
+}
+
+void Renderer2D::Execute(const RenderCommandList& commands) {
+    ProfileZone zone("Renderer2D::Execute");
+    if (!renderer) {
+        std::cerr << "Renderer is not initialized.\n";
+        return;
+    }
+
+    // Create textures acquired since the last frame and destroy ones no list can reach anymore
+    TextureCache::GetInstance().Sync(renderer, commands.generation);
+
+    const SDL_Color& clear = commands.clear_color;
+    SDL_SetRenderDrawColor(renderer, clear.r, clear.g, clear.b, clear.a);
+    SDL_RenderClear(renderer);
+
+    sprite_batch.Begin();
+    for (const SpriteCommand& sprite : commands.sprites) {
+        if (SDL_Texture* texture = sprite.texture->GetTexture()) {
+            // Frames are relative to the image; atlased images sit at an offset in their page
+            SDL_Rect src = sprite.src;
+            src.x += sprite.texture->atlas_x;
+            src.y += sprite.texture->atlas_y;
+            sprite_batch.Submit(texture, src, sprite.dest, sprite.flip_h, sprite.flip_v);
+        } else if (commands.draw_placeholders) {
+            // Still decoding or waiting for its upload slot
+            sprite_batch.Submit(GetPlaceholderTexture(), {0, 0, 1, 1}, sprite.dest, false, false);
+        }
+    }
+
+    // Draw all queued sprites, one call per run of same-texture sprites
+    sprite_batch.Flush(renderer);
+    draw_calls = sprite_batch.GetDrawCalls();
+    sprite_count = sprite_batch.GetSpriteCount();
+
+    SDL_Rect viewport;
+    SDL_RenderGetViewport(renderer, &viewport);
+    viewport_width = viewport.w;
+    viewport_height = viewport.h;
+}
+
+SDL_Texture* Renderer2D::GetPlaceholderTexture() {
+    if (!placeholder_texture) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (surface) {
+            SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 255, 255, 255, 96));
+            placeholder_texture = SDL_CreateTextureFromSurface(renderer, surface);
+            SDL_SetTextureBlendMode(placeholder_texture, SDL_BLENDMODE_BLEND);
+            SDL_FreeSurface(surface);
+        }
     }
+    return placeholder_texture;
 }
 
 SDL_Renderer* Renderer2D::GetSDLRenderer() {
     return renderer;
 }
+
+void Renderer2D::SetClearColor(Uint8 r, Uint8 g, Uint8 b) {
+    clear_color = {r, g, b, 255};
+}
+
+int Renderer2D::GetDrawCalls() const {
+    return draw_calls;
+}
+
+int Renderer2D::GetSpriteCount() const {
+    return sprite_count;
+}
+
+int Renderer2D::GetVisibleCount() const {
+    return visible_count;
+}
+
+int Renderer2D::GetCulledCount() const {
+    return culled_count;
+}
+
+void Renderer2D::SetCullingEnabled(bool enabled) {
+    culling_enabled = enabled;
+}
+
+bool Renderer2D::IsCullingEnabled() const {
+    return culling_enabled;
+}
+
+void Renderer2D::SetPlaceholdersEnabled(bool enabled) {
+    placeholders_enabled = enabled;
+}
+
+void Renderer2D::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table renderer_table = lua.create_named_table("Renderer");
+    renderer_table["get_draw_calls"] = []() {
+        return Renderer2D::GetInstance().GetDrawCalls();
+    };
+    renderer_table["get_sprite_count"] = []() {
+        return Renderer2D::GetInstance().GetSpriteCount();
+    };
+    renderer_table["get_visible_count"] = []() {
+        return Renderer2D::GetInstance().GetVisibleCount();
+    };
+    renderer_table["get_culled_count"] = []() {
+        return Renderer2D::GetInstance().GetCulledCount();
+    };
+    renderer_table["set_clear_color"] = [](int r, int g, int b) {
+        Renderer2D::GetInstance().SetClearColor(static_cast<Uint8>(r), static_cast<Uint8>(g), static_cast<Uint8>(b));
+    };
+    renderer_table["set_culling_enabled"] = [](bool enabled) {
+        Renderer2D::GetInstance().SetCullingEnabled(enabled);
+    };
+    renderer_table["set_placeholders_enabled"] = [](bool enabled) {
+        Renderer2D::GetInstance().SetPlaceholdersEnabled(enabled);
+    };
+}
@@ -0,0 +1,80 @@
+#include <SpriteBatch.hpp>
+#include <utility>
+
+void SpriteBatch::Begin() {
+    for (size_t i = 0; i < active_batches; ++i) {
+        batches[i].vertices.clear();
+        batches[i].indices.clear();
+    }
+    active_batches = 0;
+    draw_calls = 0;
+    sprite_count = 0;
+}
+
+SpriteBatch::Batch& SpriteBatch::GetBatch(SDL_Texture* texture) {
+    // Only consecutive quads share a batch, so overlapping sprites keep their submission order
+    if (active_batches > 0 && batches[active_batches - 1].texture == texture) {
+        return batches[active_batches - 1];
+    }
+
+    if (active_batches == batches.size()) {
+        batches.emplace_back();
+    }
+    Batch& batch = batches[active_batches++];
+
+    int texture_width = 0, texture_height = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
+    batch.texture = texture;
+    batch.inv_width = texture_width > 0 ? 1.0f / texture_width : 0.0f;
+    batch.inv_height = texture_height > 0 ? 1.0f / texture_height : 0.0f;
+    return batch;
+}
+
+void SpriteBatch::Submit(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dest, bool flip_h, bool flip_v) {
+    if (!texture) return;
+
+    Batch& batch = GetBatch(texture);
+
+    float u0 = src.x * batch.inv_width;
+    float v0 = src.y * batch.inv_height;
+    float u1 = (src.x + src.w) * batch.inv_width;
+    float v1 = (src.y + src.h) * batch.inv_height;
+    if (flip_h) std::swap(u0, u1);
+    if (flip_v) std::swap(v0, v1);
+
+    const SDL_Color white = {255, 255, 255, 255};
+    const int base = static_cast<int>(batch.vertices.size());
+
+    batch.vertices.push_back({{dest.x, dest.y}, white, {u0, v0}});
+    batch.vertices.push_back({{dest.x + dest.w, dest.y}, white, {u1, v0}});
+    batch.vertices.push_back({{dest.x + dest.w, dest.y + dest.h}, white, {u1, v1}});
+    batch.vertices.push_back({{dest.x, dest.y + dest.h}, white, {u0, v1}});
+
+    batch.indices.insert(batch.indices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    ++sprite_count;
+}
+
+void SpriteBatch::Flush(SDL_Renderer* renderer) {
+    for (size_t i = 0; i < active_batches; ++i) {
+        Batch& batch = batches[i];
+        if (batch.vertices.empty()) continue;
+
+        if (SDL_RenderGeometry(renderer, batch.texture,
+                               batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+                               batch.indices.data(), static_cast<int>(batch.indices.size())) != 0) {
+            std::cerr << "Failed to render sprite batch: " << SDL_GetError() << "\n";
+        }
+        ++draw_calls;
+
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+}
+
+int SpriteBatch::GetDrawCalls() const {
+    return draw_calls;
+}
+
+int SpriteBatch::GetSpriteCount() const {
+    return sprite_count;
+}
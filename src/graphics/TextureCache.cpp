@@ -0,0 +1,471 @@
+#include <TextureCache.hpp>
+#include <AssetArchive.hpp>
+#include <Profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+TextureCache& TextureCache::GetInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+TextureCache::~TextureCache() {
+    StopLoaders();
+}
+
+const CachedTexture* TextureCache::Acquire(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        ++it->second->ref_count;
+        ++stats.hits;
+        return it->second.get();
+    }
+
+    auto& entry = textures[path];
+    entry = std::make_unique<CachedTexture>();
+    entry->path = path;
+    entry->ref_count = 1;
+
+    // Images from a loaded atlas are ready as soon as the atlas page is
+    auto region = atlas_regions.find(path);
+    if (region != atlas_regions.end()) {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        entry->page = region->second.page;
+        entry->atlas_x = region->second.rect.x;
+        entry->atlas_y = region->second.rect.y;
+        entry->width = region->second.rect.w;
+        entry->height = region->second.rect.h;
+        ++entry->page->users;
+        entry->state.store(TextureState::Decoded, std::memory_order_release);
+        return entry.get();
+    }
+
+    ++stats.loads;
+    if (loaders.empty()) {
+        StartLoaders();
+    }
+    {
+        std::lock_guard<std::mutex> lock(decode_mutex);
+        decode_queue.push_back(entry.get());
+    }
+    decode_wake.notify_one();
+    return entry.get();
+}
+
+void TextureCache::Release(const std::string& path) {
+    auto it = textures.find(path);
+    if (it == textures.end()) {
+        return;
+    }
+
+    if (--it->second->ref_count <= 0) {
+        // Lists built up to this generation may still draw it
+        it->second->release_generation = generation;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            retired.push_back(std::move(it->second));
+        }
+        textures.erase(it);
+        ++stats.evictions;
+    }
+}
+
+uint64_t TextureCache::AdvanceGeneration() {
+    return ++generation;
+}
+
+void TextureCache::Sync(SDL_Renderer* renderer, uint64_t current_generation) {
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(pending_mutex);
+
+    // Upload atlases loaded since the last frame
+    for (auto& page : pages) {
+        if (page->surface) {
+            page->texture = SDL_CreateTextureFromSurface(renderer, page->surface);
+            if (!page->texture) {
+                std::cerr << "Failed to create atlas texture: " << SDL_GetError() << "\n";
+                ++load_stats.failures;
+            }
+            SDL_FreeSurface(page->surface);
+            page->surface = nullptr;
+        }
+    }
+
+    // Destroy what no list from this generation on can reference, once its loader is done with it
+    auto destroyed = std::partition(retired.begin(), retired.end(), [&](const std::unique_ptr<CachedTexture>& entry) {
+        TextureState state = entry->state.load(std::memory_order_acquire);
+        return entry->release_generation >= current_generation
+            || state == TextureState::Queued || state == TextureState::Decoding;
+    });
+    for (auto it = destroyed; it != retired.end(); ++it) {
+        CachedTexture* entry = it->get();
+        if (entry->surface) {
+            uploads.erase(std::remove(uploads.begin(), uploads.end(), entry), uploads.end());
+            SDL_FreeSurface(entry->surface);
+        }
+        if (entry->texture) {
+            SDL_DestroyTexture(entry->texture);
+        }
+        if (entry->page) {
+            ReleasePage(entry->page);
+        }
+    }
+    retired.erase(destroyed, retired.end());
+
+    // Spread uploads over frames so a burst of new sprites doesn't stall one of them
+    size_t uploaded_bytes = 0;
+    while (!uploads.empty()) {
+        CachedTexture* entry = uploads.front();
+        size_t bytes = static_cast<size_t>(entry->surface->pitch) * entry->surface->h;
+        if (uploaded_bytes > 0 && uploaded_bytes + bytes > upload_budget) {
+            break;
+        }
+        uploads.pop_front();
+        uploaded_bytes += bytes;
+
+        if (atlas_enabled && PlaceInAtlas(renderer, *entry)) {
+            entry->state.store(TextureState::Uploaded, std::memory_order_release);
+            ++load_stats.uploaded;
+            ++load_stats.atlased;
+        } else if ((entry->texture = SDL_CreateTextureFromSurface(renderer, entry->surface))) {
+            entry->state.store(TextureState::Uploaded, std::memory_order_release);
+            ++load_stats.uploaded;
+        } else {
+            std::cerr << "Failed to create texture: " << SDL_GetError() << "\n";
+            entry->state.store(TextureState::Failed, std::memory_order_release);
+            ++load_stats.failures;
+        }
+        SDL_FreeSurface(entry->surface);
+        entry->surface = nullptr;
+    }
+    load_stats.upload_ms_last = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool TextureCache::PlaceInAtlas(SDL_Renderer* renderer, CachedTexture& entry) {
+    SDL_Surface* surface = entry.surface;
+    if (surface->w > atlas_max_image_size || surface->h > atlas_max_image_size) {
+        return false;
+    }
+
+    // Padding keeps neighbours from bleeding into each other when sampled
+    SDL_Rect rect;
+    AtlasPage* target = nullptr;
+    for (auto& page : pages) {
+        if (page->packer.GetWidth() > 0 && page->packer.Insert(surface->w + atlas_padding, surface->h + atlas_padding, rect)) {
+            target = page.get();
+            break;
+        }
+    }
+
+    if (!target) {
+        int size = atlas_page_size;
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+            size = std::min({size, info.max_texture_width, info.max_texture_height});
+        }
+        SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+        if (!texture) {
+            return false;
+        }
+        // Static textures start undefined; padding has to be transparent
+        std::vector<Uint32> blank(static_cast<size_t>(size) * size, 0);
+        SDL_UpdateTexture(texture, nullptr, blank.data(), size * static_cast<int>(sizeof(Uint32)));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        auto page = std::make_unique<AtlasPage>();
+        page->texture = texture;
+        page->packer.Reset(size, size);
+        if (!page->packer.Insert(surface->w + atlas_padding, surface->h + atlas_padding, rect)) {
+            SDL_DestroyTexture(texture);
+            return false;
+        }
+        target = page.get();
+        pages.push_back(std::move(page));
+        load_stats.atlas_pages = pages.size();
+    }
+
+    // Loaders convert to ARGB8888 already; anything else is converted here
+    SDL_Surface* pixels = surface;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        pixels = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    }
+    if (!pixels) {
+        return false;
+    }
+    SDL_Rect destination = {rect.x, rect.y, surface->w, surface->h};
+    SDL_UpdateTexture(target->texture, &destination, pixels->pixels, pixels->pitch);
+    if (pixels != surface) {
+        SDL_FreeSurface(pixels);
+    }
+
+    entry.page = target;
+    entry.atlas_x = rect.x;
+    entry.atlas_y = rect.y;
+    ++target->users;
+    return true;
+}
+
+void TextureCache::ReleasePage(AtlasPage* page) {
+    if (--page->users > 0) {
+        return;
+    }
+    // Packed space can't be reused piecemeal, so the page goes once it is empty
+    if (page->texture) SDL_DestroyTexture(page->texture);
+    if (page->surface) SDL_FreeSurface(page->surface);
+    pages.erase(std::remove_if(pages.begin(), pages.end(), [page](const std::unique_ptr<AtlasPage>& candidate) {
+        return candidate.get() == page;
+    }), pages.end());
+    load_stats.atlas_pages = pages.size();
+}
+
+void TextureCache::Clear() {
+    auto destroy = [](CachedTexture& entry) {
+        if (entry.surface) SDL_FreeSurface(entry.surface);
+        if (entry.texture) SDL_DestroyTexture(entry.texture);
+    };
+
+    // Loaders write into entries, so they have to stop first
+    StopLoaders();
+
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    for (auto& [path, entry] : textures) {
+        destroy(*entry);
+        ++stats.evictions;
+    }
+    textures.clear();
+    for (auto& entry : retired) {
+        destroy(*entry);
+    }
+    retired.clear();
+    uploads.clear();
+    for (auto& page : pages) {
+        if (page->texture) SDL_DestroyTexture(page->texture);
+        if (page->surface) SDL_FreeSurface(page->surface);
+    }
+    pages.clear();
+    load_stats.atlas_pages = 0;
+    atlas_regions.clear();
+}
+
+void TextureCache::StartLoaders() {
+    {
+        std::lock_guard<std::mutex> lock(decode_mutex);
+        stopping_loaders = false;
+    }
+    for (int i = 0; i < loader_count; ++i) {
+        loaders.emplace_back(&TextureCache::LoaderLoop, this);
+    }
+}
+
+void TextureCache::StopLoaders() {
+    {
+        std::lock_guard<std::mutex> lock(decode_mutex);
+        stopping_loaders = true;
+        decode_queue.clear();
+    }
+    decode_wake.notify_all();
+    for (auto& loader : loaders) {
+        loader.join();
+    }
+    loaders.clear();
+    decode_idle.notify_all();
+}
+
+void TextureCache::LoaderLoop() {
+    Profiler::SetThreadName("texture loader");
+    while (true) {
+        CachedTexture* entry = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(decode_mutex);
+            decode_wake.wait(lock, [this]() { return stopping_loaders || !decode_queue.empty(); });
+            if (stopping_loaders) {
+                return;
+            }
+            entry = decode_queue.front();
+            decode_queue.pop_front();
+            ++decoding;
+        }
+        entry->state.store(TextureState::Decoding, std::memory_order_relaxed);
+
+        auto start = std::chrono::steady_clock::now();
+        SDL_RWops* stream = AssetArchive::GetInstance().Open(entry->path);
+        SDL_Surface* surface = stream ? IMG_Load_RW(stream, 1) : nullptr;
+        if (surface) {
+            // Convert here so the upload on the rendering thread is a plain copy
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (converted) {
+                SDL_FreeSurface(surface);
+                surface = converted;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double decode_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        Profiler::GetInstance().Record("TextureCache::Decode", start, end);
+
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            if (surface) {
+                entry->width = surface->w;
+                entry->height = surface->h;
+                entry->surface = surface;
+                uploads.push_back(entry);
+                ++load_stats.decoded;
+                load_stats.decode_ms_total += decode_ms;
+                load_stats.decode_ms_max = std::max(load_stats.decode_ms_max, decode_ms);
+                entry->state.store(TextureState::Decoded, std::memory_order_release);
+            } else {
+                std::cerr << "Failed to load texture: " << IMG_GetError() << "\n";
+                ++load_stats.failures;
+                entry->state.store(TextureState::Failed, std::memory_order_release);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(decode_mutex);
+            --decoding;
+        }
+        decode_idle.notify_all();
+    }
+}
+
+void TextureCache::WaitForDecodes() {
+    std::unique_lock<std::mutex> lock(decode_mutex);
+    decode_idle.wait(lock, [this]() { return decode_queue.empty() && decoding == 0; });
+}
+
+void TextureCache::SetUploadBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    upload_budget = bytes;
+}
+
+void TextureCache::SetAtlasEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    atlas_enabled = enabled;
+}
+
+bool TextureCache::LoadAtlas(const std::string& metadata_path) {
+    std::string_view archived;
+    std::istringstream file;
+    if (AssetArchive::GetInstance().Read(metadata_path, archived)) {
+        file.str(std::string(archived));
+    } else {
+        std::ifstream loose(metadata_path);
+        if (!loose) {
+            std::cerr << "Failed to open atlas: " << metadata_path << "\n";
+            return false;
+        }
+        file.str(std::string(std::istreambuf_iterator<char>(loose), std::istreambuf_iterator<char>()));
+    }
+
+    // Format written by AtlasBuilder:
+    //   image <file relative to the metadata> <width> <height>
+    //   sprite <x> <y> <width> <height> <path>
+    const std::filesystem::path directory = std::filesystem::path(metadata_path).parent_path();
+    std::string image_path;
+    std::vector<std::pair<std::string, SDL_Rect>> sprites;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "image") {
+            std::string name;
+            fields >> name;
+            image_path = (directory / name).generic_string();
+        } else if (kind == "sprite") {
+            SDL_Rect rect;
+            std::string path;
+            if (fields >> rect.x >> rect.y >> rect.w >> rect.h >> std::ws && std::getline(fields, path)) {
+                sprites.emplace_back(path, rect);
+            }
+        }
+    }
+
+    SDL_RWops* stream = image_path.empty() ? nullptr : AssetArchive::GetInstance().Open(image_path);
+    SDL_Surface* surface = stream ? IMG_Load_RW(stream, 1) : nullptr;
+    if (!surface) {
+        std::cerr << "Failed to load atlas image for " << metadata_path << ": " << IMG_GetError() << "\n";
+        return false;
+    }
+
+    auto page = std::make_unique<AtlasPage>();
+    page->surface = surface;
+    page->users = 1; // Pinned for as long as the cache lives
+    for (const auto& [path, rect] : sprites) {
+        atlas_regions[path] = {page.get(), rect};
+    }
+
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    pages.push_back(std::move(page));
+    load_stats.atlas_pages = pages.size();
+    std::cout << "Loaded atlas " << metadata_path << " with " << sprites.size() << " images\n";
+    return true;
+}
+
+size_t TextureCache::GetResidentCount() const {
+    return textures.size();
+}
+
+const TextureCacheStats& TextureCache::GetStats() const {
+    return stats;
+}
+
+TextureLoadStats TextureCache::GetLoadStats() {
+    TextureLoadStats result;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        result = load_stats;
+        result.pending_uploads = uploads.size();
+    }
+    std::lock_guard<std::mutex> lock(decode_mutex);
+    result.queued = decode_queue.size() + decoding;
+    return result;
+}
+
+void TextureCache::Register() {
+    sol::state& lua = LuaManager::GetInstance();
+    sol::table cache_table = lua.create_named_table("TextureCache");
+    cache_table["get_stats"] = [](sol::this_state ts) {
+        sol::state_view lua(ts);
+        TextureCache& cache = TextureCache::GetInstance();
+        const TextureCacheStats& stats = cache.GetStats();
+
+        int references = 0;
+        for (const auto& [path, entry] : cache.textures) {
+            references += entry->ref_count;
+        }
+
+        const TextureLoadStats load_stats = cache.GetLoadStats();
+
+        sol::table result = lua.create_table();
+        result["loads"] = stats.loads;
+        result["hits"] = stats.hits;
+        result["evictions"] = stats.evictions;
+        result["failures"] = load_stats.failures;
+        result["resident"] = cache.GetResidentCount();
+        result["references"] = references;
+        result["queued"] = load_stats.queued;
+        result["pending_uploads"] = load_stats.pending_uploads;
+        result["decoded"] = load_stats.decoded;
+        result["uploaded"] = load_stats.uploaded;
+        result["decode_ms_avg"] = load_stats.decoded > 0 ? load_stats.decode_ms_total / load_stats.decoded : 0.0;
+        result["decode_ms_max"] = load_stats.decode_ms_max;
+        result["upload_ms_last"] = load_stats.upload_ms_last;
+        result["atlas_pages"] = load_stats.atlas_pages;
+        result["atlased"] = load_stats.atlased;
+        return result;
+    };
+    cache_table["set_upload_budget"] = [](size_t bytes) {
+        TextureCache::GetInstance().SetUploadBudget(bytes);
+    };
+    cache_table["set_atlas_enabled"] = [](bool enabled) {
+        TextureCache::GetInstance().SetAtlasEnabled(enabled);
+    };
+    cache_table["load_atlas"] = [](const std::string& metadata_path) {
+        return TextureCache::GetInstance().LoadAtlas(metadata_path);
+    };
+}
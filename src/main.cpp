@@ -1,8 +1,7 @@
 #define SDL_MAIN_HANDLED
-#include <chrono>
-#include <thread>
 #include <iostream>
 #include <filesystem>
+#include <vector>
 #include <SDL2/SDL.h>
 #include <RegistryManager.hpp>
 #include <Object.hpp>
@@ -10,11 +9,29 @@
 #include <ComponentManager.hpp>
 #include <LuaManager.hpp>
 #include <Renderer2D.hpp>
+#include <RenderThread.hpp>
+#include <TextureCache.hpp>
+#include <AtlasBuilder.hpp>
 #include <ProjectManager.hpp>
+#include <Benchmark.hpp>
+#include <GameLoop.hpp>
+#include <TransformSystem.hpp>
+#include <SpatialHash2D.hpp>
+#include <PhysicsSystem.hpp>
+#include <JobSystem.hpp>
+#include <ScriptCache.hpp>
+#include <ScriptWatcher.hpp>
+#include <AssetArchive.hpp>
+#include <Profiler.hpp>
+#include <LuaProfiler.hpp>
+#include <Logger.hpp>
+#include <InputSystem.hpp>
+#include <InputRecorder.hpp>
 
 // Function to load and set the window icon
 void SetWindowIcon(SDL_Window* window, const std::string& iconPath) {
-    SDL_Surface* icon = SDL_LoadBMP(iconPath.c_str());
+    SDL_RWops* stream = AssetArchive::GetInstance().Open(iconPath);
+    SDL_Surface* icon = stream ? SDL_LoadBMP_RW(stream, 1) : nullptr;
     if (!icon) {
         std::cerr << "Failed to load window icon: " << SDL_GetError() << std::endl;
         return;
@@ -24,32 +41,166 @@ void SetWindowIcon(SDL_Window* window, const std::string& iconPath) {
 }
 
 int main(int argc, char* argv[]) {
+    // Start the log writer first so it outlives every singleton that logs while shutting down
+    Logger& logger = Logger::GetInstance();
+
     // Set the working directory to the executable's directory
     std::filesystem::path exe_path = std::filesystem::absolute(argv[0]).parent_path();
     std::filesystem::current_path(exe_path);
 
     std::cout << "Working directory set to: " << std::filesystem::current_path() << "\n";
 
+    // Benchmarks run without a window: Rogue --benchmark <name> [count]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        if (argc < 3) {
+            Benchmark::List();
+            return -1;
+        }
+        // Keep stdout to the benchmark's JSON: no lifecycle spam, and nothing written behind its back
+        logger.SetCategoryEnabled(LogCategory::Lifecycle, false);
+        logger.Shutdown();
+        RegisterComponents();
+        JobSystem::GetInstance().Initialize();
+        int result = Benchmark::Run(argv[2], argc > 3 ? std::atoi(argv[3]) : 0);
+        JobSystem::GetInstance().Shutdown();
+        return result;
+    }
+
+    // Offline atlas packing: Rogue --pack-atlas <output.png> <image>...
+    if (argc > 1 && std::string(argv[1]) == "--pack-atlas") {
+        if (argc < 4) {
+            return AtlasBuilder::Run("", {});
+        }
+        return AtlasBuilder::Run(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+
+    // Offline asset packing: Rogue --pack-assets <output.pak> [--lz4] <dir>...
+    if (argc > 1 && std::string(argv[1]) == "--pack-assets") {
+        bool compress = argc > 3 && std::string(argv[3]) == "--lz4";
+        int first_root = compress ? 4 : 3;
+        if (argc <= first_root) {
+            std::cerr << "Usage: --pack-assets <output.pak> [--lz4] <dir>...\n";
+            return -1;
+        }
+        return AssetArchive::Build(argv[2], std::vector<std::string>(argv + first_root, argv + argc), compress);
+    }
+
+    // Headless runs draw into an offscreen software surface: Rogue --headless [--frames N]
+    // --workers N sizes the job pool (0 = single-threaded), --job-trace prints the last frame's jobs on exit,
+    // --no-render-thread draws on the main thread instead of a dedicated render thread,
+    // --script-cache DIR persists compiled script bytecode between runs,
+    // --no-hot-reload stops watching scripts/ for edits (headless runs never watch),
+    // --atlas FILE serves images from a prebuilt atlas, --no-atlas keeps one texture per image,
+    // --archive FILE mounts a packed asset archive (data.pak is mounted automatically if present),
+    // --profile FILE records CPU zones from startup and writes a Chrome trace on exit,
+    // --lua-profile FILE samples Lua from startup and writes folded stacks on exit,
+    // --record-input FILE saves every frame's input, --replay-input FILE feeds a recording back step for step,
+    // --log-level debug|info|warning|error drops quieter messages, --no-lifecycle-log hides object/component lifecycle spam
+    bool headless = false;
+    bool job_trace = false;
+    bool threaded_render = true;
+    bool hot_reload = true;
+    std::vector<std::string> atlas_files;
+    std::string profile_file;
+    std::string lua_profile_file;
+    std::string record_input_file;
+    std::string replay_input_file;
+    int worker_count = -1; // -1 = one per core, minus the main thread
+    uint64_t max_frames = 0; // 0 = run until quit
+    if (std::filesystem::exists("data.pak")) {
+        AssetArchive::GetInstance().Mount("data.pak");
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            max_frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            worker_count = std::atoi(argv[++i]);
+        } else if (arg == "--job-trace") {
+            job_trace = true;
+        } else if (arg == "--no-render-thread") {
+            threaded_render = false;
+        } else if (arg == "--no-hot-reload") {
+            hot_reload = false;
+        } else if (arg == "--atlas" && i + 1 < argc) {
+            atlas_files.push_back(argv[++i]);
+        } else if (arg == "--no-atlas") {
+            TextureCache::GetInstance().SetAtlasEnabled(false);
+        } else if (arg == "--script-cache" && i + 1 < argc) {
+            ScriptCache::GetInstance().SetDiskCacheDirectory(argv[++i]);
+        } else if (arg == "--archive" && i + 1 < argc) {
+            AssetArchive::GetInstance().Mount(argv[++i]);
+        } else if (arg == "--profile" && i + 1 < argc) {
+            profile_file = argv[++i];
+        } else if (arg == "--lua-profile" && i + 1 < argc) {
+            lua_profile_file = argv[++i];
+        } else if (arg == "--record-input" && i + 1 < argc) {
+            record_input_file = argv[++i];
+        } else if (arg == "--replay-input" && i + 1 < argc) {
+            replay_input_file = argv[++i];
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            LogLevel level;
+            if (Logger::ParseLevel(argv[++i], level)) {
+                logger.SetLevel(level);
+            } else {
+                std::cerr << "Unknown log level: " << argv[i] << "\n";
+            }
+        } else if (arg == "--no-lifecycle-log") {
+            logger.SetCategoryEnabled(LogCategory::Lifecycle, false);
+        }
+    }
+
+    Profiler::SetThreadName("main");
+    Profiler::GetInstance().SetEnabled(!profile_file.empty());
+
     // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+    if (SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO) != 0) {
         std::cerr << "SDL Init Failed: " << SDL_GetError() << std::endl;
         return -1;
     }
 
-    // Create SDL window
-    SDL_Window* window = SDL_CreateWindow("Rogue Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
-    if (!window) {
-        std::cerr << "Failed to create window: " << SDL_GetError() << std::endl;
-        SDL_Quit();
-        return -1;
+    SDL_Window* window = nullptr;
+    SDL_Surface* headless_surface = nullptr;
+    SDL_Renderer* renderer = nullptr; // Only set when rendering on the main thread
+    RenderThread render_thread;
+
+    if (headless) {
+        headless_surface = SDL_CreateRGBSurfaceWithFormat(0, 800, 600, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!headless_surface) {
+            std::cerr << "Failed to create headless surface: " << SDL_GetError() << std::endl;
+            SDL_Quit();
+            return -1;
+        }
+    } else {
+        // Create SDL window
+        window = SDL_CreateWindow("Rogue Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
+        if (!window) {
+            std::cerr << "Failed to create window: " << SDL_GetError() << std::endl;
+            SDL_Quit();
+            return -1;
+        }
+        SetWindowIcon(window, "assets/icon.ico");
     }
-    SetWindowIcon(window, "assets/icon.ico");
 
-    // Create SDL renderer
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
+    // Create SDL renderer on the thread that will draw with it
+    auto create_renderer = [&]() {
+        return headless ? SDL_CreateSoftwareRenderer(headless_surface)
+                        : SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    };
+    bool renderer_ready = false;
+    if (threaded_render) {
+        renderer_ready = render_thread.Start(create_renderer);
+    } else {
+        renderer = create_renderer();
+        renderer_ready = renderer != nullptr;
+    }
+
+    if (!renderer_ready) {
         std::cerr << "Failed to create renderer: " << SDL_GetError() << std::endl;
-        SDL_DestroyWindow(window);
+        if (window) SDL_DestroyWindow(window);
+        if (headless_surface) SDL_FreeSurface(headless_surface);
         SDL_Quit();
         return -1;
     }
@@ -60,59 +211,190 @@ int main(int argc, char* argv[]) {
     // Register Lua environment
     RegisterComponents();
 
-    // Create the Renderer instance
-    Renderer2D::GetInstance().Initialize(renderer);
+    // The render thread initializes Renderer2D itself
+    if (!threaded_render) {
+        Renderer2D::GetInstance().Initialize(renderer);
+    }
+    Renderer2D::Register();
+    TextureCache::Register();
+    for (const std::string& atlas_file : atlas_files) {
+        TextureCache::GetInstance().LoadAtlas(atlas_file);
+    }
+    SpatialHash2D::Register();
+    PhysicsSystem::Register();
+    JobSystem::Register();
+    ScriptCache::Register();
+    ScriptWatcher::Register();
+    AssetArchive::Register();
+    Profiler::Register();
+    LuaProfiler::Register();
+    Logger::Register();
+    if (!lua_profile_file.empty()) {
+        LuaProfiler::GetInstance().Start();
+    }
+    JobSystem::GetInstance().Initialize(worker_count);
     Renderer2D& ecsRenderer = Renderer2D::GetInstance();
     auto root = Object::Create();
     root->SetScript("scripts/main.lua");
-    // Define target FPS and frame duration
-    constexpr int target_fps = 60;
-    constexpr float frame_duration = 1.0f / target_fps;
-    
-    SDL_Event event;
-
-    // Game loop
-    bool running = true;
-    while (running) {
-        auto frame_start = std::chrono::high_resolution_clock::now();
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
+    if (hot_reload && !headless) {
+        ScriptWatcher::GetInstance().Watch("scripts");
+    }
+
+    InputSystem& input_system = InputSystem::GetInstance();
+
+    // Game loop: fixed 60 Hz simulation, interpolated rendering
+    GameLoopSettings loop_settings;
+    loop_settings.fixed_step = 1.0f / 60.0f;
+    loop_settings.target_fps = headless ? 0 : 60;
+    loop_settings.lockstep = headless;
+    GameLoop game_loop(loop_settings);
+
+    // Replays drive the step count from the recording so the simulation sees the same ticks
+    InputRecorder& input_recorder = InputRecorder::GetInstance();
+    if (!replay_input_file.empty()) {
+        if (input_recorder.StartReplay(replay_input_file, loop_settings.fixed_step)) {
+            game_loop.SetStepCount([&]() { return input_recorder.GetReplaySteps(); });
+        }
+    } else if (!record_input_file.empty()) {
+        input_recorder.StartRecording(record_input_file, loop_settings.fixed_step);
+    }
+
+    game_loop.Run(
+        [&]() {
+            ProfileZone zone("Input");
+
+            // Recycle last frame's jobs and keep its trace for inspection
+            JobSystem::GetInstance().BeginFrame();
+
+            // Pick up edited scripts before this frame runs them
+            ScriptWatcher::GetInstance().Poll();
+
+            // Gather the frame's events once; engine keys are handled here, scripts get them below
+            input_system.Collect();
+
+            bool running = true;
+            for (const SDL_Event& event : input_system.GetEvents()) {
+                if (event.type == SDL_QUIT) {
+                    running = false;
+                }
+                // F9 starts recording CPU zones; pressing it again writes profile.json and stops
+                if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F9 && !event.key.repeat) {
+                    Profiler& profiler = Profiler::GetInstance();
+                    if (profiler.IsEnabled()) {
+                        profiler.WriteChromeTrace("profile.json");
+                        profiler.SetEnabled(false);
+                    } else {
+                        profiler.Clear();
+                        profiler.SetEnabled(true);
+                    }
+                }
+                // F10 does the same for the Lua sampler, writing lua_profile.folded
+                if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F10 && !event.key.repeat) {
+                    LuaProfiler& lua_profiler = LuaProfiler::GetInstance();
+                    if (lua_profiler.IsRunning()) {
+                        lua_profiler.Stop();
+                        lua_profiler.WriteFolded("lua_profile.folded");
+                        lua_profiler.PrintReport(std::cout);
+                    } else {
+                        lua_profiler.Clear();
+                        lua_profiler.Start();
+                    }
+                }
+            }
+
+            // Scripts see the recorded input instead of the live one while replaying
+            if (input_recorder.IsReplaying()) {
+                if (!input_recorder.ReplayFrame(input_system)) {
+                    running = false;
+                }
+                for (const SDL_Event& event : input_system.GetEvents()) {
+                    if (event.type == SDL_QUIT) {
+                        running = false;
+                    }
+                }
+            } else if (input_recorder.IsRecording()) {
+                input_recorder.RecordFrame(input_system, game_loop.GetSimulatedFrames());
+            }
+            input_system.Dispatch();
+            if (max_frames > 0 && game_loop.GetRenderedFrames() >= max_frames) {
                 running = false;
             }
-            root->ProcessInput(event); // Process input events
+            return running;
+        },
+        [&](float step) {
+            ProfileZone zone("Simulate");
 
-        }
-        // Process all objects, including the root
-        root->Process(frame_duration);
+            // Process all objects, including the root
+            root->Process(step);
+            Object::DestroyQueued();
 
-        // Clear the screen
-        SDL_SetRenderDrawColor(renderer, 164, 157, 157, 255);
-        SDL_RenderClear(renderer);
+            // Integrate bodies natively so scripts don't move them every step
+            {
+                ProfileZone physics_zone("PhysicsSystem::Step");
+                PhysicsSystem::GetInstance().Step(step);
+            }
 
-        // Render all entities
-        ecsRenderer.Render(frame_duration);
+            // Resolve the transform hierarchy once per step, then re-bucket what moved
+            {
+                ProfileZone transform_zone("TransformSystem::Update");
+                TransformSystem::GetInstance().Update();
+            }
+            ProfileZone spatial_zone("SpatialHash2D::Update");
+            SpatialHash2D::GetInstance().Update();
+        },
+        [&](float alpha, float frame_time) {
+            ProfileZone zone("Frame");
+            if (threaded_render) {
+                // Record the frame and hand it to the render thread, which draws while we simulate the next one
+                ecsRenderer.BuildCommands(render_thread.GetFrameCommands(), frame_time, alpha);
+                render_thread.Submit();
+                return;
+            }
 
-        // Present the rendered frame
-        SDL_RenderPresent(renderer);
+            // Render all entities and present the frame
+            ecsRenderer.Render(frame_time, alpha);
+            SDL_RenderPresent(renderer);
+        });
 
-        // Frame limiting: Sleep to maintain 60 FPS
-        auto frame_end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<float> elapsed = frame_end - frame_start;
-        if (elapsed.count() < frame_duration) {
-            std::this_thread::sleep_for(std::chrono::duration<float>(frame_duration - elapsed.count()));
-        }
-    }
+    std::cout << "Game loop exited. Simulated " << game_loop.GetSimulatedFrames()
+              << " frames, rendered " << game_loop.GetRenderedFrames()
+              << " frames, dropped " << game_loop.GetDroppedTime() << "s.\n";
+    input_recorder.Stop(game_loop.GetSimulatedFrames());
 
-    std::cout << "Game loop exited. Simulation complete.\n";
+    JobSystem::GetInstance().BeginFrame();
+    if (!profile_file.empty()) {
+        Profiler::GetInstance().WriteChromeTrace(profile_file);
+    }
+    if (!lua_profile_file.empty()) {
+        LuaProfiler::GetInstance().Stop();
+        LuaProfiler::GetInstance().WriteFolded(lua_profile_file);
+        LuaProfiler::GetInstance().PrintReport(std::cout);
+    }
+    if (job_trace) {
+        JobSystem::GetInstance().PrintTrace(std::cout);
+    }
+    JobSystem::GetInstance().Shutdown();
+    ScriptWatcher::GetInstance().Stop();
 
-    // Clean up SDL
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
+    // Release sprites and their textures while the renderer is still alive
     // manager.DestroyAllObjects();  // Destroy all objects
     RegistryManager::GetInstance().clear();  // Clear all entities and components
+    if (threaded_render) {
+        std::cout << "Render thread presented " << render_thread.GetPresentedFrames() << " frames.\n";
+        render_thread.Stop(); // Clears the texture cache and destroys the renderer on its own thread
+    } else {
+        TextureCache::GetInstance().Clear();
+        Renderer2D::GetInstance().Shutdown();
+        SDL_DestroyRenderer(renderer);
+    }
     lua.collect_garbage();  // Explicitly collect garbage to clean up Lua objects
     std::cout << "Cleaned up Registry and Lua.\n";
 
+    // Clean up SDL
+    if (window) SDL_DestroyWindow(window);
+    if (headless_surface) SDL_FreeSurface(headless_surface);
+    SDL_Quit();
+
+    logger.Shutdown();
     return 0;
 }